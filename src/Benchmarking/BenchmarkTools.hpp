@@ -0,0 +1,115 @@
+#ifndef MPAGSCIPHER_BENCHMARKTOOLS_HPP
+#define MPAGSCIPHER_BENCHMARKTOOLS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/**
+ * \file BenchmarkTools.hpp
+ * \brief Contains helper functions shared between the benchmark programs
+ */
+
+/**
+ * \namespace BenchmarkTools
+ * \brief Namespace to hold the benchmarking helper functions
+ */
+namespace BenchmarkTools {
+    /**
+     * \brief Create a deterministic pseudo-random string of uppercase letters
+     *
+     * \param size the number of characters to generate
+     * \param seed the seed for the generator, so that runs are reproducible
+     * \return the generated text
+     */
+    inline std::string makeUppercaseText(const std::size_t size,
+                                         std::uint32_t seed = 12345)
+    {
+        std::string text(size, 'A');
+        for (auto& c : text) {
+            // Simple linear congruential generator - we only need the
+            // letters to be varied, not statistically random
+            seed = seed * 1664525u + 1013904223u;
+            c = static_cast<char>('A' + (seed >> 24) % 26);
+        }
+        return text;
+    }
+
+    /**
+     * \brief Create a deterministic pseudo-random string of mixed raw input
+     *
+     * Mostly lowercase and uppercase letters, with some digits, spaces,
+     * punctuation and newlines, like the text a user would supply
+     *
+     * \param size the number of characters to generate
+     * \param seed the seed for the generator, so that runs are reproducible
+     * \return the generated text
+     */
+    inline std::string makeMixedText(const std::size_t size,
+                                     std::uint32_t seed = 12345)
+    {
+        const std::string others{"0123456789     ,.;'!?\n"};
+        std::string text(size, 'a');
+        for (auto& c : text) {
+            seed = seed * 1664525u + 1013904223u;
+            const std::uint32_t r{seed >> 16};
+            if (r % 8 == 0) {
+                c = others[(r >> 3) % others.size()];
+            } else {
+                c = static_cast<char>(((r % 8 == 1) ? 'A' : 'a') +
+                                      (r >> 3) % 26);
+            }
+        }
+        return text;
+    }
+
+    /**
+     * \brief Time a single call of the supplied function
+     *
+     * \param func the function to time
+     * \return the elapsed wall time in seconds
+     */
+    template <typename Func>
+    double timeSeconds(Func&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(stop - start).count();
+    }
+
+    /**
+     * \brief Print the throughput achieved when processing the given number of bytes
+     *
+     * \param label the name of the thing that was measured
+     * \param nBytes the number of bytes that were processed
+     * \param seconds the time that the processing took
+     */
+    inline void reportThroughput(const std::string& label,
+                                 const std::size_t nBytes,
+                                 const double seconds)
+    {
+        const double bytesPerSecond{static_cast<double>(nBytes) / seconds};
+        std::cout << label << ": " << nBytes << " bytes in " << seconds
+                  << " s = " << bytesPerSecond << " bytes/s ("
+                  << bytesPerSecond / 1e9 << " GB/s)" << std::endl;
+    }
+
+    /**
+     * \brief Read the input size from the command line, if one was supplied
+     *
+     * \param argc the number of command-line arguments
+     * \param argv the command-line arguments
+     * \param defaultSize the size to use if none was given
+     * \return the number of bytes to process
+     */
+    inline std::size_t inputSizeFromArgs(const int argc, char* argv[],
+                                         const std::size_t defaultSize)
+    {
+        return (argc > 1) ? std::stoull(argv[1]) : defaultSize;
+    }
+}    // namespace BenchmarkTools
+
+#endif    // MPAGSCIPHER_BENCHMARKTOOLS_HPP
@@ -0,0 +1,76 @@
+//! Message-rate benchmark for applying the ciphers to batches of short messages
+#include "BenchmarkTools.hpp"
+
+#include "CipherFactory.hpp"
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+    // Default to a million messages, but allow fewer for quick runs
+    const std::size_t nMessages{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 1ul << 20)};
+
+    // Messages of between 20 and 200 characters, stored one after another
+    std::vector<std::size_t> offsets{0};
+    std::size_t length{20};
+    for (std::size_t i{0}; i < nMessages; ++i) {
+        length = 20 + (length * 37 + i) % 181;
+        offsets.push_back(offsets.back() + length);
+    }
+    const std::string messages{
+        BenchmarkTools::makeUppercaseText(offsets.back())};
+
+    for (const auto& [type, name, key] :
+         {std::make_tuple(CipherType::Caesar, "Caesar", "10"),
+          std::make_tuple(CipherType::Vigenere, "Vigenere", "playfairexample"),
+          std::make_tuple(CipherType::Playfair, "Playfair", "playfairexample")}) {
+        // One cipher and one std::string for each message
+        std::string oneByOne;
+        const double oneByOneTime{BenchmarkTools::timeSeconds([&, &type = type,
+                                                                &key = key] {
+            for (std::size_t i{0}; i < nMessages; ++i) {
+                const auto cipher = cipherFactory(type, key);
+                oneByOne += cipher->applyCipher(
+                    messages.substr(offsets[i], offsets[i + 1] - offsets[i]),
+                    CipherMode::Encrypt);
+            }
+        })};
+
+        // One cipher and one call for the whole batch
+        std::string batch;
+        std::vector<std::size_t> outputOffsets;
+        const double batchTime{BenchmarkTools::timeSeconds([&, &type = type,
+                                                             &key = key] {
+            const auto cipher = cipherFactory(type, key);
+            batch.resize(cipher->batchOutputSize(offsets));
+            batch.resize(cipher->applyCipherBatch(messages, offsets,
+                                                  batch.data(), outputOffsets,
+                                                  CipherMode::Encrypt));
+        })};
+
+        std::cout << name << " (one at a time): " << nMessages
+                  << " messages in " << oneByOneTime << " s = "
+                  << static_cast<double>(nMessages) / oneByOneTime
+                  << " messages/s" << std::endl;
+        std::cout << name << " (batch): " << nMessages << " messages in "
+                  << batchTime << " s = "
+                  << static_cast<double>(nMessages) / batchTime
+                  << " messages/s" << std::endl;
+        std::cout << "Speed-up: " << oneByOneTime / batchTime << "x"
+                  << std::endl;
+
+        // Sanity check that both approaches agree
+        if (batch != oneByOne) {
+            std::cerr << "[error] " << name << " outputs differ" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
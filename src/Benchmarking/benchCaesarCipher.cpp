@@ -0,0 +1,62 @@
+//! Throughput benchmark for the MPAGSCipher CaesarCipher Class
+#include "BenchmarkTools.hpp"
+
+#include "Alphabet.hpp"
+#include "CaesarCipher.hpp"
+
+#include <iostream>
+#include <string>
+
+namespace {
+    /// The original implementation, which scans the alphabet for every character
+    std::string linearScanCaesar(const std::string& inputText,
+                                 const std::size_t key)
+    {
+        std::string outputText;
+        char processedChar{'x'};
+        for (const auto& origChar : inputText) {
+            for (std::size_t i{0}; i < Alphabet::size; ++i) {
+                if (origChar == Alphabet::alphabet[i]) {
+                    processedChar =
+                        Alphabet::alphabet[(i + key) % Alphabet::size];
+                    break;
+                }
+            }
+            outputText += processedChar;
+        }
+        return outputText;
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Default to 1 GB of input, but allow a smaller size for quick runs
+    const std::size_t inputSize{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 1ul << 30)};
+    const std::size_t key{10};
+
+    const std::string inputText{BenchmarkTools::makeUppercaseText(inputSize)};
+
+    std::string before;
+    const double beforeTime{BenchmarkTools::timeSeconds(
+        [&] { before = linearScanCaesar(inputText, key); })};
+    BenchmarkTools::reportThroughput("Caesar (linear scan)", inputSize,
+                                     beforeTime);
+
+    const CaesarCipher cipher{key};
+    std::string after;
+    const double afterTime{BenchmarkTools::timeSeconds(
+        [&] { after = cipher.applyCipher(inputText, CipherMode::Encrypt); })};
+    BenchmarkTools::reportThroughput("Caesar (lookup table)", inputSize,
+                                     afterTime);
+
+    std::cout << "Speed-up: " << beforeTime / afterTime << "x" << std::endl;
+
+    // Sanity check that both implementations agree
+    if (after != before) {
+        std::cerr << "[error] outputs differ" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+//! Throughput benchmark for each of the Caesar shift kernels
+#include "BenchmarkTools.hpp"
+
+#include "CaesarCipher.hpp"
+#include "ShiftKernels.hpp"
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    // Default to 1 GB of input, but allow a smaller size for quick runs
+    const std::size_t inputSize{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 1ul << 30)};
+
+    const std::string inputText{BenchmarkTools::makeUppercaseText(inputSize)};
+    const CaesarCipher cipher{10};
+
+    std::string reference;
+    for (const auto kernel :
+         {ShiftKernels::Kernel::Scalar, ShiftKernels::Kernel::SSE2,
+          ShiftKernels::Kernel::AVX2}) {
+        const std::string label{"Caesar (" + ShiftKernels::kernelName(kernel) +
+                                ")"};
+        if (!ShiftKernels::isSupported(kernel)) {
+            std::cout << label << ": not supported on this CPU" << std::endl;
+            continue;
+        }
+        ShiftKernels::setActiveKernel(kernel);
+
+        std::string outputText;
+        const double seconds{BenchmarkTools::timeSeconds([&] {
+            outputText = cipher.applyCipher(inputText, CipherMode::Encrypt);
+        })};
+        BenchmarkTools::reportThroughput(label, inputSize, seconds);
+
+        // Check that every kernel agrees with the scalar one
+        if (reference.empty()) {
+            reference.swap(outputText);
+        } else if (outputText != reference) {
+            std::cerr << "[error] " << label << " output differs" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
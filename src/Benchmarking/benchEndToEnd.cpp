@@ -0,0 +1,307 @@
+//! End-to-end throughput benchmark, running the mpags-cipher program on generated corpora
+#include "BenchmarkTools.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+namespace {
+    /// The settings for a run of the harness
+    struct E2ESettings {
+        /// The mpags-cipher program to run
+        std::string executable{MPAGS_CIPHER_EXECUTABLE};
+        /// Where to write the corpora and outputs
+        std::string workDir{"."};
+        /// The corpus sizes, in bytes
+        std::vector<std::size_t> sizes{std::size_t{1} << 20,
+                                       100 * (std::size_t{1} << 20),
+                                       std::size_t{1} << 30};
+        /// The numbers of threads to run with
+        std::vector<std::size_t> threads{1,
+                                         std::max(1u, std::thread::hardware_concurrency())};
+        /// Where to write the results as JSON (not written if empty)
+        std::string jsonFile;
+    };
+
+    /// The kinds of corpus that are generated
+    enum class Corpus { Letters, Mixed, Repetitive };
+
+    std::string corpusName(const Corpus corpus)
+    {
+        switch (corpus) {
+            case Corpus::Letters:
+                return "letters";
+            case Corpus::Mixed:
+                return "mixed";
+            case Corpus::Repetitive:
+                return "repetitive";
+        }
+        return "unknown";
+    }
+
+    /// Write a deterministic corpus of the given kind and size, a block at a time
+    void writeCorpus(const std::string& path, const Corpus corpus,
+                     const std::size_t size)
+    {
+        // Doubled letters, which make the Playfair cipher insert padding
+        const std::string repeated{"BALLOONKEEPERSSAIDLLAMASOOZEFFEEDBEE"};
+
+        std::ofstream file{path, std::ios::binary};
+        const std::size_t blockSize{std::size_t{1} << 20};
+        std::uint32_t seed{2021};
+        for (std::size_t written{0}; written < size; written += blockSize) {
+            const std::size_t n{std::min(blockSize, size - written)};
+            std::string block;
+            switch (corpus) {
+                case Corpus::Letters:
+                    block = BenchmarkTools::makeUppercaseText(n, seed++);
+                    break;
+                case Corpus::Mixed:
+                    block = BenchmarkTools::makeMixedText(n, seed++);
+                    break;
+                case Corpus::Repetitive:
+                    for (std::size_t i{0}; i < n; ++i) {
+                        block += repeated[(written + i) % repeated.size()];
+                    }
+                    break;
+            }
+            file.write(block.data(), static_cast<std::streamsize>(n));
+        }
+        if (!file.good()) {
+            throw std::runtime_error("failed to write corpus '" + path + "'");
+        }
+    }
+
+    /// What was measured for one run of the program
+    struct RunResult {
+        /// The wall-clock time, in seconds
+        double wallSeconds;
+        /// The CPU time spent in user and kernel mode, in seconds
+        double cpuSeconds;
+        /// The peak resident set size, in bytes
+        std::size_t maxRssBytes;
+        /// The exit status of the program
+        int exitStatus;
+    };
+
+    double toSeconds(const timeval& time)
+    {
+        return static_cast<double>(time.tv_sec) +
+               1e-6 * static_cast<double>(time.tv_usec);
+    }
+
+    /// Run the program with the given arguments and measure its resource use
+    RunResult runProgram(const std::vector<std::string>& args)
+    {
+        std::vector<char*> argv;
+        for (const auto& arg : args) {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        const auto start = std::chrono::steady_clock::now();
+        pid_t pid{0};
+        if (::posix_spawn(&pid, argv[0], nullptr, nullptr, argv.data(),
+                          environ) != 0) {
+            throw std::runtime_error("failed to run '" + args[0] + "'");
+        }
+        int status{0};
+        rusage usage{};
+        if (::wait4(pid, &status, 0, &usage) != pid) {
+            throw std::runtime_error("failed to wait for '" + args[0] + "'");
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        return RunResult{
+            std::chrono::duration<double>(stop - start).count(),
+            toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime),
+#ifdef __APPLE__
+            static_cast<std::size_t>(usage.ru_maxrss),
+#else
+            static_cast<std::size_t>(usage.ru_maxrss) * 1024,
+#endif
+            WIFEXITED(status) ? WEXITSTATUS(status) : -1};
+    }
+
+    /// Parse a comma separated list of numbers
+    std::vector<std::size_t> parseList(const std::string& list)
+    {
+        std::vector<std::size_t> values;
+        std::stringstream stream{list};
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            values.push_back(std::stoull(item));
+        }
+        if (values.empty()) {
+            throw std::invalid_argument("empty list");
+        }
+        return values;
+    }
+
+    /// Read the settings from the command line
+    bool processArgs(const std::vector<std::string>& args,
+                     E2ESettings& settings)
+    {
+        for (std::size_t i{1}; i < args.size(); ++i) {
+            const bool hasValue{i + 1 < args.size()};
+            if (args[i] == "--exe" && hasValue) {
+                settings.executable = args[++i];
+            } else if (args[i] == "--dir" && hasValue) {
+                settings.workDir = args[++i];
+            } else if (args[i] == "--sizes" && hasValue) {
+                settings.sizes = parseList(args[++i]);
+            } else if (args[i] == "--threads" && hasValue) {
+                settings.threads = parseList(args[++i]);
+            } else if (args[i] == "-o" && hasValue) {
+                settings.jsonFile = args[++i];
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    E2ESettings settings;
+    bool argsOk{false};
+    try {
+        argsOk = processArgs({argv, argv + argc}, settings);
+    } catch (const std::logic_error&) {
+        argsOk = false;
+    }
+    if (!argsOk) {
+        std::cerr
+            << "Usage: benchEndToEnd [--exe <mpags-cipher>] [--dir <dir>] [--sizes <n,...>] [--threads <n,...>] [-o <file>]\n"
+            << "  Defaults: sizes of 1 MB, 100 MB and 1 GB, 1 thread and one per hardware thread"
+            << std::endl;
+        return 1;
+    }
+
+    const std::vector<std::pair<std::string, std::string>> ciphers{
+        {"caesar", "17"}, {"vigenere", "mpagscipher"}, {"playfair", "playfair"}};
+    const std::string outputPath{settings.workDir + "/e2e-output.txt"};
+
+    std::ostringstream json;
+    json << "{\n  \"runs\": [\n";
+    bool firstRun{true};
+
+    std::cout << std::left << std::setw(11) << "corpus" << std::setw(12)
+              << "bytes" << std::setw(10) << "cipher" << std::setw(9)
+              << "mode" << std::setw(8) << "io" << std::setw(8) << "threads"
+              << std::right << std::setw(10) << "wall/s" << std::setw(12)
+              << "MB/s" << std::setw(12) << "maxRSS/MB" << std::setw(8)
+              << "CPU%" << std::endl;
+
+    for (const auto corpus : {Corpus::Letters, Corpus::Mixed, Corpus::Repetitive}) {
+        for (const std::size_t size : settings.sizes) {
+            const std::string inputPath{settings.workDir + "/e2e-" +
+                                        corpusName(corpus) + "-" +
+                                        std::to_string(size) + ".txt"};
+            try {
+                writeCorpus(inputPath, corpus, size);
+            } catch (const std::runtime_error& error) {
+                std::cerr << "[error] " << error.what() << std::endl;
+                return 1;
+            }
+
+            for (const auto& [cipher, key] : ciphers) {
+                for (const std::string mode : {"--encrypt", "--decrypt"}) {
+                    for (const bool stream : {false, true}) {
+                        for (const std::size_t nThreads : settings.threads) {
+                            std::vector<std::string> args{
+                                settings.executable, "-c", cipher, "-k", key,
+                                mode, "--threads", std::to_string(nThreads),
+                                "-i", inputPath, "-o", outputPath};
+                            if (stream) {
+                                args.push_back("--stream");
+                            }
+
+                            RunResult result{};
+                            try {
+                                result = runProgram(args);
+                            } catch (const std::runtime_error& error) {
+                                std::cerr << "[error] " << error.what()
+                                          << std::endl;
+                                return 1;
+                            }
+                            if (result.exitStatus != 0) {
+                                std::cerr << "[error] mpags-cipher exited with status "
+                                          << result.exitStatus << std::endl;
+                                return 1;
+                            }
+
+                            const double bytesPerSecond{
+                                static_cast<double>(size) / result.wallSeconds};
+                            const double cpuUtilisation{
+                                result.cpuSeconds / result.wallSeconds};
+                            const std::string io{stream ? "stream" : "whole"};
+
+                            std::cout << std::left << std::setw(11)
+                                      << corpusName(corpus) << std::setw(12)
+                                      << size << std::setw(10) << cipher
+                                      << std::setw(9) << mode.substr(2)
+                                      << std::setw(8) << io << std::setw(8)
+                                      << nThreads << std::right << std::fixed
+                                      << std::setprecision(3) << std::setw(10)
+                                      << result.wallSeconds
+                                      << std::setprecision(1) << std::setw(12)
+                                      << bytesPerSecond / 1e6 << std::setw(12)
+                                      << static_cast<double>(result.maxRssBytes) / 1e6
+                                      << std::setw(8) << 100 * cpuUtilisation
+                                      << std::defaultfloat << std::endl;
+
+                            json << (firstRun ? "" : ",\n") << "    {\"corpus\": \""
+                                 << corpusName(corpus) << "\", \"input_size\": "
+                                 << size << ", \"cipher\": \"" << cipher
+                                 << "\", \"mode\": \"" << mode.substr(2)
+                                 << "\", \"io\": \"" << io
+                                 << "\", \"threads\": " << nThreads
+                                 << ", \"wall_seconds\": " << result.wallSeconds
+                                 << ", \"bytes_per_second\": " << bytesPerSecond
+                                 << ", \"max_rss_bytes\": " << result.maxRssBytes
+                                 << ", \"cpu_utilisation\": " << cpuUtilisation
+                                 << "}";
+                            firstRun = false;
+                        }
+                    }
+                }
+            }
+            std::remove(inputPath.c_str());
+        }
+    }
+    std::remove(outputPath.c_str());
+    json << "\n  ]\n}\n";
+
+    if (!settings.jsonFile.empty()) {
+        std::ofstream jsonStream{settings.jsonFile};
+        if (!jsonStream.good()) {
+            std::cerr << "[error] failed to create ostream on file '"
+                      << settings.jsonFile << "'" << std::endl;
+            return 1;
+        }
+        jsonStream << json.str();
+    }
+
+    return 0;
+}
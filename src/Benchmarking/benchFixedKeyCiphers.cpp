@@ -0,0 +1,85 @@
+//! Throughput benchmark for the compile-time keyed ciphers against the runtime-keyed ones
+#include "BenchmarkTools.hpp"
+
+#include "CaesarCipher.hpp"
+#include "FixedKeyCiphers.hpp"
+#include "VigenereCipher.hpp"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+namespace {
+    /// Time applying the cipher to the whole text, and to it as a series of short messages
+    double timeCipher(const Cipher& cipher, const std::string& inputText,
+                      std::string& outputText, const std::size_t messageSize)
+    {
+        return BenchmarkTools::timeSeconds([&] {
+            for (std::size_t i{0}; i < inputText.size(); i += messageSize) {
+                const std::string_view message{
+                    std::string_view{inputText}.substr(i, messageSize)};
+                cipher.applyCipher(TextChunk{message, 0}, outputText.data() + i,
+                                   CipherMode::Encrypt);
+            }
+        });
+    }
+
+    /// Time the runtime-keyed and fixed-key ciphers on the same text and check that they agree
+    bool compare(const std::string& name, const Cipher& runtime,
+                 const Cipher& fixed, const std::string& inputText)
+    {
+        // Write into buffers that have already been touched, so that only
+        // the ciphers themselves are measured
+        std::string before(inputText.size(), '\0');
+        std::string after(inputText.size(), '\0');
+
+        for (const std::size_t messageSize : {inputText.size(), std::size_t{64}}) {
+            const std::string label{
+                name + ((messageSize == inputText.size())
+                            ? std::string{}
+                            : ", " + std::to_string(messageSize) +
+                                  " byte messages")};
+
+            const double beforeTime{
+                timeCipher(runtime, inputText, before, messageSize)};
+            BenchmarkTools::reportThroughput(label + " (runtime key)",
+                                             inputText.size(), beforeTime);
+
+            const double afterTime{
+                timeCipher(fixed, inputText, after, messageSize)};
+            BenchmarkTools::reportThroughput(label + " (fixed key)",
+                                             inputText.size(), afterTime);
+
+            std::cout << "Speed-up: " << beforeTime / afterTime << "x"
+                      << std::endl;
+
+            if (after != before) {
+                std::cerr << "[error] " << label << " outputs differ"
+                          << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Default to 1 GB of input, but allow a smaller size for quick runs
+    const std::size_t inputSize{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 1ul << 30)};
+
+    const std::string inputText{BenchmarkTools::makeUppercaseText(inputSize)};
+
+    const bool caesarOk{compare("Caesar 13", CaesarCipher{13},
+                                CaesarKernel<13>{}, inputText)};
+    const bool shortKeyOk{compare("Vigenere KEY", VigenereCipher{"KEY"},
+                                  VigenereKernel<'K', 'E', 'Y'>{}, inputText)};
+    const bool longKeyOk{compare(
+        "Vigenere PLAYFAIREXAMPLE", VigenereCipher{"PLAYFAIREXAMPLE"},
+        VigenereKernel<'P', 'L', 'A', 'Y', 'F', 'A', 'I', 'R', 'E', 'X', 'A',
+                       'M', 'P', 'L', 'E'>{},
+        inputText)};
+
+    return (caesarOk && shortKeyOk && longKeyOk) ? 0 : 1;
+}
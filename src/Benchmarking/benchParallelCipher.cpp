@@ -0,0 +1,62 @@
+//! Scaling benchmark for applying the ciphers with multiple threads
+#include "BenchmarkTools.hpp"
+
+#include "CipherFactory.hpp"
+#include "ParallelCipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <tuple>
+
+int main(int argc, char* argv[])
+{
+    // Default to 1 GB of input, but allow a smaller size for quick runs
+    const std::size_t inputSize{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 1ul << 30)};
+
+    // Go up to (at least) 16 threads, or the number of hardware threads
+    const std::size_t maxThreads{
+        std::max(std::thread::hardware_concurrency(), 16u)};
+
+    const std::string inputText{BenchmarkTools::makeUppercaseText(inputSize)};
+
+    for (const auto& [type, name, key] :
+         {std::make_tuple(CipherType::Caesar, "Caesar", "10"),
+          std::make_tuple(CipherType::Vigenere, "Vigenere", "playfairexample"),
+          std::make_tuple(CipherType::Playfair, "Playfair", "playfairexample")}) {
+        const auto cipher = cipherFactory(type, key);
+
+        double serialTime{0.0};
+        std::string reference;
+        for (std::size_t nThreads{1}; nThreads <= maxThreads; nThreads *= 2) {
+            ThreadPool pool{nThreads};
+
+            std::string outputText;
+            const double seconds{BenchmarkTools::timeSeconds([&] {
+                outputText = applyCipherParallel(*cipher, inputText,
+                                                 CipherMode::Encrypt, pool);
+            })};
+            const std::string label{std::string{name} + " (" +
+                                    std::to_string(nThreads) + " threads)"};
+            BenchmarkTools::reportThroughput(label, inputSize, seconds);
+
+            if (nThreads == 1) {
+                serialTime = seconds;
+                reference.swap(outputText);
+            } else {
+                std::cout << "Speed-up: " << serialTime / seconds << "x"
+                          << std::endl;
+                if (outputText != reference) {
+                    std::cerr << "[error] " << label << " output differs"
+                              << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
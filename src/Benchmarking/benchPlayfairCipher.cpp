@@ -0,0 +1,131 @@
+//! Throughput benchmark for the MPAGSCipher PlayfairCipher Class
+#include "BenchmarkTools.hpp"
+
+#include "Alphabet.hpp"
+#include "PlayfairCipher.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace {
+    /// The original implementation, which uses std::map for the grid lookups
+    class MapPlayfair {
+      public:
+        explicit MapPlayfair(const std::string& key)
+        {
+            std::string grid{key + std::string{Alphabet::alphabet}};
+            std::transform(std::begin(grid), std::end(grid), std::begin(grid),
+                           ::toupper);
+            grid.erase(std::remove_if(std::begin(grid), std::end(grid),
+                                      [](char c) { return !std::isalpha(c); }),
+                       std::end(grid));
+            std::transform(std::begin(grid), std::end(grid), std::begin(grid),
+                           [](char c) { return (c == 'J') ? 'I' : c; });
+            std::string lettersFound{""};
+            grid.erase(std::remove_if(std::begin(grid), std::end(grid),
+                                      [&](char c) {
+                                          if (lettersFound.find(c) ==
+                                              std::string::npos) {
+                                              lettersFound += c;
+                                              return false;
+                                          }
+                                          return true;
+                                      }),
+                       std::end(grid));
+            for (std::size_t i{0}; i < 25; ++i) {
+                const auto coords = std::make_pair(i / 5, i % 5);
+                charLookup_[grid[i]] = coords;
+                coordLookup_[coords] = grid[i];
+            }
+        }
+
+        /// Encrypt text that has already been prepared into digraphs
+        std::string encryptDigraphs(std::string text) const
+        {
+            for (std::size_t i{0}; i < text.size(); i += 2) {
+                Coords pointOne{charLookup_.at(text[i])};
+                Coords pointTwo{charLookup_.at(text[i + 1])};
+                auto& [rowOne, columnOne]{pointOne};
+                auto& [rowTwo, columnTwo]{pointTwo};
+                if (rowOne == rowTwo) {
+                    columnOne = (columnOne + 1) % 5;
+                    columnTwo = (columnTwo + 1) % 5;
+                } else if (columnOne == columnTwo) {
+                    rowOne = (rowOne + 1) % 5;
+                    rowTwo = (rowTwo + 1) % 5;
+                } else {
+                    std::swap(columnOne, columnTwo);
+                }
+                text[i] = coordLookup_.at(pointOne);
+                text[i + 1] = coordLookup_.at(pointTwo);
+            }
+            return text;
+        }
+
+      private:
+        using Coords = std::pair<std::size_t, std::size_t>;
+        std::map<char, Coords> charLookup_;
+        std::map<Coords, char> coordLookup_;
+    };
+
+    /// Make text that needs no Playfair padding, i.e. already valid digraphs
+    std::string makeDigraphText(const std::size_t size)
+    {
+        std::string text{BenchmarkTools::makeUppercaseText(size & ~1ul)};
+        for (std::size_t i{0}; i < text.size(); i += 2) {
+            if (text[i] == 'J') {
+                text[i] = 'I';
+            }
+            if (text[i + 1] == 'J') {
+                text[i + 1] = 'I';
+            }
+            if (text[i] == text[i + 1]) {
+                text[i + 1] = (text[i] == 'A') ? 'B' : 'A';
+            }
+        }
+        return text;
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    // Default to 100 MB of input, but allow a different size
+    const std::size_t inputSize{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 100000000ul)};
+    const std::string key{"playfairexample"};
+
+    const std::string inputText{makeDigraphText(inputSize)};
+
+    const MapPlayfair mapCipher{key};
+    std::string before;
+    const double beforeTime{BenchmarkTools::timeSeconds(
+        [&] { before = mapCipher.encryptDigraphs(inputText); })};
+    BenchmarkTools::reportThroughput("Playfair (std::map)", inputText.size(),
+                                     beforeTime);
+
+    // Run both with and without the precomputed digraph tables
+    for (const bool precompute : {false, true}) {
+        const PlayfairCipher cipher{key, precompute};
+        const std::string label{precompute ? "Playfair (digraph tables)"
+                                           : "Playfair (flat arrays)"};
+        std::string after;
+        const double afterTime{BenchmarkTools::timeSeconds([&] {
+            after = cipher.applyCipher(inputText, CipherMode::Encrypt);
+        })};
+        BenchmarkTools::reportThroughput(label, inputText.size(), afterTime);
+
+        std::cout << "Speed-up: " << beforeTime / afterTime << "x"
+                  << std::endl;
+
+        // Sanity check that both implementations agree
+        if (after != before) {
+            std::cerr << "[error] outputs differ" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
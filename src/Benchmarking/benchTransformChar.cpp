@@ -0,0 +1,80 @@
+//! Throughput benchmark for the MPAGSCipher input transliteration
+#include "BenchmarkTools.hpp"
+
+#include "ShiftKernels.hpp"
+#include "TransformChar.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+int main(int argc, char* argv[])
+{
+    // Default to 256 MB of input, but allow a smaller size for quick runs
+    const std::size_t inputSize{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 1ul << 28)};
+
+    const std::string rawText{BenchmarkTools::makeMixedText(inputSize)};
+
+    // The original approach: extract one character at a time from a stream
+    // and append a new string for each one
+    std::string before;
+    const double beforeTime{BenchmarkTools::timeSeconds([&] {
+        std::istringstream inputStream{rawText};
+        char inputChar{'x'};
+        while (inputStream >> inputChar) {
+            before += transformChar(inputChar);
+        }
+    })};
+    BenchmarkTools::reportThroughput("transformChar (per character)",
+                                     inputSize, beforeTime);
+
+    std::string after;
+    const double afterTime{BenchmarkTools::timeSeconds([&] {
+        after.resize(maxTransformedCharSize * rawText.size());
+        after.resize(transformText(rawText, after.data()));
+    })};
+    BenchmarkTools::reportThroughput("transformText (block)", inputSize,
+                                     afterTime);
+
+    std::cout << "Speed-up: " << beforeTime / afterTime << "x" << std::endl;
+
+    // Sanity check that both implementations agree
+    if (after != before) {
+        std::cerr << "[error] outputs differ" << std::endl;
+        return 1;
+    }
+
+    // Compare the kernels, on the mixed text and on text without digits
+    // (the common case, which the vectorised kernel handles)
+    std::string lettersText{rawText};
+    for (auto& c : lettersText) {
+        if (c >= '0' && c <= '9') {
+            c = ' ';
+        }
+    }
+    for (const auto kernel :
+         {ShiftKernels::Kernel::Scalar, ShiftKernels::Kernel::AVX2}) {
+        if (!ShiftKernels::isSupported(kernel)) {
+            continue;
+        }
+        ShiftKernels::setActiveKernel(kernel);
+        for (const auto& [label, text] :
+             {std::make_pair("mixed text", rawText.data()),
+              std::make_pair("no digits", static_cast<const char*>(lettersText.data()))}) {
+            std::string output(maxTransformedCharSize * inputSize, '\0');
+            const double time{BenchmarkTools::timeSeconds([&] {
+                transformText(std::string_view{text, inputSize},
+                              output.data());
+            })};
+            BenchmarkTools::reportThroughput(
+                "transformText (" + ShiftKernels::kernelName(kernel) + ", " +
+                    label + ")",
+                inputSize, time);
+        }
+    }
+
+    return 0;
+}
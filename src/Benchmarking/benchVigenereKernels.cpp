@@ -0,0 +1,55 @@
+//! Throughput benchmark for each of the Vigenere shift kernels
+#include "BenchmarkTools.hpp"
+
+#include "ShiftKernels.hpp"
+#include "VigenereCipher.hpp"
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    // Default to 256 MB of input, but allow a different size
+    const std::size_t inputSize{
+        BenchmarkTools::inputSizeFromArgs(argc, argv, 1ul << 28)};
+
+    const std::string inputText{BenchmarkTools::makeUppercaseText(inputSize)};
+
+    for (const std::size_t keySize : {1, 5, 32, 1000}) {
+        const VigenereCipher cipher{
+            BenchmarkTools::makeUppercaseText(keySize, 999)};
+
+        std::string reference;
+        for (const auto kernel :
+             {ShiftKernels::Kernel::Scalar, ShiftKernels::Kernel::SSE2,
+              ShiftKernels::Kernel::AVX2}) {
+            const std::string label{"Vigenere key length " +
+                                    std::to_string(keySize) + " (" +
+                                    ShiftKernels::kernelName(kernel) + ")"};
+            if (!ShiftKernels::isSupported(kernel)) {
+                std::cout << label << ": not supported on this CPU"
+                          << std::endl;
+                continue;
+            }
+            ShiftKernels::setActiveKernel(kernel);
+
+            std::string outputText;
+            const double seconds{BenchmarkTools::timeSeconds([&] {
+                outputText =
+                    cipher.applyCipher(inputText, CipherMode::Encrypt);
+            })};
+            BenchmarkTools::reportThroughput(label, inputSize, seconds);
+
+            // Check that every kernel agrees with the scalar one
+            if (reference.empty()) {
+                reference.swap(outputText);
+            } else if (outputText != reference) {
+                std::cerr << "[error] " << label << " output differs"
+                          << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+//! Benchmark suite for the MPAGSCipher library, writing its results as JSON
+#include "BenchmarkTools.hpp"
+
+#include "CipherFactory.hpp"
+#include "ShiftKernels.hpp"
+#include "TextChunk.hpp"
+#include "TransformChar.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// The settings for a run of the suite
+    struct BenchSettings {
+        /// The smallest input size to measure
+        std::size_t minSize{16};
+        /// The largest input size to measure
+        std::size_t maxSize{std::size_t{1} << 30};
+        /// The least time to spend repeating each measurement, in seconds
+        double minTime{0.1};
+        /// Where to write the results (stdout if empty)
+        std::string outputFile;
+    };
+
+    /// The result of measuring one benchmark
+    struct BenchResult {
+        /// The name of the benchmark
+        std::string name;
+        /// The cipher or function measured
+        std::string subject;
+        /// The length of the key used, zero if there is none
+        std::size_t keyLength;
+        /// The number of bytes of input processed by each iteration
+        std::size_t inputSize;
+        /// The number of times the measured code was run
+        std::size_t iterations;
+        /// The mean time for each iteration, in nanoseconds
+        double meanNs;
+        /// The fastest iteration, in nanoseconds
+        double minNs;
+    };
+
+    /// Run the function repeatedly for at least the minimum time and record how long it took
+    template <typename Func>
+    BenchResult measure(const std::string& name, const std::string& subject,
+                        const std::size_t keyLength,
+                        const std::size_t inputSize, const double minTime,
+                        Func&& func)
+    {
+        std::size_t iterations{0};
+        double totalSeconds{0.0};
+        double minSeconds{std::numeric_limits<double>::max()};
+        while (iterations == 0 || totalSeconds < minTime) {
+            const double seconds{BenchmarkTools::timeSeconds(func)};
+            totalSeconds += seconds;
+            minSeconds = std::min(minSeconds, seconds);
+            ++iterations;
+        }
+        return BenchResult{name,
+                           subject,
+                           keyLength,
+                           inputSize,
+                           iterations,
+                           1e9 * totalSeconds / static_cast<double>(iterations),
+                           1e9 * minSeconds};
+    }
+
+    /// The input sizes to measure: 16 bytes then every factor of 16 up to the maximum
+    std::vector<std::size_t> inputSizes(const BenchSettings& settings)
+    {
+        std::vector<std::size_t> sizes;
+        std::size_t size{settings.minSize};
+        for (; size < settings.maxSize; size *= 16) {
+            sizes.push_back(size);
+        }
+        sizes.push_back(settings.maxSize);
+        return sizes;
+    }
+
+    /// Build a key of uppercase letters of the given length
+    std::string makeKey(const std::size_t length)
+    {
+        return BenchmarkTools::makeUppercaseText(length, 54321);
+    }
+
+    /// Allocate an output buffer without touching its memory, since only
+    /// the part of it that is written to needs to be backed by real pages
+    std::unique_ptr<char[]> makeBuffer(const std::size_t size)
+    {
+        return std::unique_ptr<char[]>{new char[size]};
+    }
+
+    /// Write the results as a JSON document
+    void writeJson(std::ostream& out, const std::vector<BenchResult>& results)
+    {
+        out << "{\n"
+            << "  \"context\": {\n"
+            << "    \"hardware_concurrency\": "
+            << std::thread::hardware_concurrency() << ",\n"
+            << "    \"kernel\": \""
+            << ShiftKernels::kernelName(ShiftKernels::activeKernel())
+            << "\"\n"
+            << "  },\n"
+            << "  \"benchmarks\": [\n";
+        for (std::size_t i{0}; i < results.size(); ++i) {
+            const BenchResult& result{results[i]};
+            const double bytesPerSecond{
+                (result.inputSize == 0)
+                    ? 0.0
+                    : 1e9 * static_cast<double>(result.inputSize) /
+                          result.meanNs};
+            out << "    {\"name\": \"" << result.name << "\", \"subject\": \""
+                << result.subject << "\", \"key_length\": " << result.keyLength
+                << ", \"input_size\": " << result.inputSize
+                << ", \"iterations\": " << result.iterations
+                << ", \"mean_ns\": " << result.meanNs
+                << ", \"min_ns\": " << result.minNs
+                << ", \"bytes_per_second\": " << bytesPerSecond << "}"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n"
+            << "}\n";
+    }
+
+    /// Read the settings from the command line
+    bool processArgs(const std::vector<std::string>& args,
+                     BenchSettings& settings)
+    {
+        for (std::size_t i{1}; i < args.size(); ++i) {
+            const bool hasValue{i + 1 < args.size()};
+            if (args[i] == "--min-size" && hasValue) {
+                settings.minSize = std::stoull(args[++i]);
+            } else if (args[i] == "--max-size" && hasValue) {
+                settings.maxSize = std::stoull(args[++i]);
+            } else if (args[i] == "--min-time" && hasValue) {
+                settings.minTime = std::stod(args[++i]);
+            } else if (args[i] == "-o" && hasValue) {
+                settings.outputFile = args[++i];
+            } else {
+                return false;
+            }
+        }
+        return settings.minSize > 0 && settings.minSize <= settings.maxSize;
+    }
+}    // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchSettings settings;
+    bool argsOk{false};
+    try {
+        argsOk = processArgs({argv, argv + argc}, settings);
+    } catch (const std::logic_error&) {
+        argsOk = false;
+    }
+    if (!argsOk) {
+        std::cerr
+            << "Usage: mpags-bench [--min-size <bytes>] [--max-size <bytes>] [--min-time <seconds>] [-o <file>]\n"
+            << "  Defaults: 16 bytes to 1 GB, 0.1 s per measurement, results to stdout"
+            << std::endl;
+        return 1;
+    }
+
+    std::vector<BenchResult> results;
+    const std::vector<std::size_t> sizes{inputSizes(settings)};
+
+    // Construction latency of each cipher (through the factory, as main does)
+    for (const std::size_t keyLength : {1, 8, 64}) {
+        const std::string key{makeKey(keyLength)};
+        for (const auto& [type, name] :
+             {std::make_pair(CipherType::Playfair, "Playfair"),
+              std::make_pair(CipherType::Vigenere, "Vigenere")}) {
+            results.push_back(measure(
+                "cipherFactory/" + std::string{name}, "cipherFactory",
+                keyLength, 0, settings.minTime,
+                [&, type = type] { cipherFactory(type, key); }));
+        }
+    }
+    results.push_back(measure("cipherFactory/Caesar", "cipherFactory", 0, 0,
+                              settings.minTime, [] {
+                                  cipherFactory(CipherType::Caesar, "17");
+                              }));
+
+    for (const std::size_t size : sizes) {
+        std::cerr << "[mpags-bench] input size " << size << std::endl;
+
+        // Transliteration of raw mixed text
+        {
+            const std::string rawText{BenchmarkTools::makeMixedText(size)};
+            const auto output = makeBuffer(maxTransformedCharSize * size);
+            results.push_back(measure("transformText", "transformText", 0,
+                                      size, settings.minTime, [&] {
+                                          transformText(rawText, output.get());
+                                      }));
+            results.push_back(measure("transformChar", "transformChar", 0,
+                                      size, settings.minTime, [&] {
+                                          std::size_t n{0};
+                                          for (const char c : rawText) {
+                                              n += transformChar(c).size();
+                                          }
+                                          return n;
+                                      }));
+        }
+
+        // The ciphers on already transliterated text
+        const std::string text{BenchmarkTools::makeUppercaseText(size)};
+        std::vector<std::pair<CipherType, std::string>> cases{
+            {CipherType::Caesar, "17"}};
+        for (const std::size_t keyLength : {1, 8, 64}) {
+            cases.emplace_back(CipherType::Vigenere, makeKey(keyLength));
+            cases.emplace_back(CipherType::Playfair, makeKey(keyLength));
+        }
+        for (const auto& [type, key] : cases) {
+            const auto cipher = cipherFactory(type, key);
+            const std::string subject{
+                (type == CipherType::Caesar)
+                    ? "CaesarCipher"
+                    : (type == CipherType::Vigenere) ? "VigenereCipher"
+                                                     : "PlayfairCipher"};
+            const auto output = makeBuffer(cipher->maxOutputSize(size));
+            for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+                const std::string name{
+                    subject + "/" +
+                    (mode == CipherMode::Encrypt ? "encrypt" : "decrypt")};
+                results.push_back(measure(
+                    name, subject,
+                    (type == CipherType::Caesar) ? 0 : key.size(), size,
+                    settings.minTime, [&, mode = mode] {
+                        cipher->applyCipher(TextChunk{text, 0}, output.get(),
+                                            mode);
+                    }));
+            }
+        }
+    }
+
+    if (settings.outputFile.empty()) {
+        writeJson(std::cout, results);
+    } else {
+        std::ofstream outputStream{settings.outputFile};
+        if (!outputStream.good()) {
+            std::cerr << "[error] failed to create ostream on file '"
+                      << settings.outputFile << "'" << std::endl;
+            return 1;
+        }
+        writeJson(outputStream, results);
+    }
+
+    return 0;
+}
@@ -1,7 +1,10 @@
 #ifndef MPAGSCIPHER_ALPHABET_HPP
 #define MPAGSCIPHER_ALPHABET_HPP
 
-#include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 /**
  * \file Alphabet.hpp
@@ -11,13 +14,95 @@
 /**
  * \namespace Alphabet
  * \brief Namespace to hold alphabet-related constants
+ *
+ * Everything here is constexpr, so it is built at compile time rather
+ * than initialised when the program starts, and lookups with constant
+ * arguments fold away entirely
  */
 namespace Alphabet {
     /// The alphabet
-    const std::string alphabet{"ABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+    inline constexpr std::string_view alphabet{"ABCDEFGHIJKLMNOPQRSTUVWXYZ"};
 
     /// The size of the alphabet
-    const std::size_t size{alphabet.size()};
+    inline constexpr std::size_t size{alphabet.size()};
+
+    /// The value in the index table for bytes that are not in the alphabet
+    inline constexpr std::uint8_t notInAlphabet{0xFF};
+
+    /**
+     * \brief Build the table giving the position in the alphabet of every possible byte
+     *
+     * \return the table, holding notInAlphabet for bytes that are not letters of the alphabet
+     */
+    constexpr std::array<std::uint8_t, 256> makeIndexTable()
+    {
+        std::array<std::uint8_t, 256> table{};
+        for (auto& entry : table) {
+            entry = notInAlphabet;
+        }
+        for (std::size_t i{0}; i < size; ++i) {
+            table[static_cast<unsigned char>(alphabet[i])] =
+                static_cast<std::uint8_t>(i);
+        }
+        return table;
+    }
+
+    /// The position in the alphabet of every possible byte
+    inline constexpr std::array<std::uint8_t, 256> indexTable{makeIndexTable()};
+
+    /**
+     * \brief Whether the character is a letter of the alphabet
+     *
+     * \param c the character to check
+     * \return true if the character is in the alphabet
+     */
+    constexpr bool contains(const char c)
+    {
+        return indexTable[static_cast<unsigned char>(c)] != notInAlphabet;
+    }
+
+    /**
+     * \brief Get the position of a letter in the alphabet
+     *
+     * \param c the letter, which must be in the alphabet
+     * \return the position of the letter
+     */
+    constexpr std::size_t index(const char c)
+    {
+        return indexTable[static_cast<unsigned char>(c)];
+    }
+
+    /**
+     * \brief Get the letter at a position in the alphabet, wrapping around past the end
+     *
+     * \param i the position
+     * \return the letter at position i modulo the size of the alphabet
+     */
+    constexpr char letter(const std::size_t i)
+    {
+        return alphabet[i % size];
+    }
+
+    // The ciphers and their vectorised kernels rely on the alphabet being
+    // exactly the contiguous range of uppercase ASCII letters
+    static_assert(size == 26, "the alphabet must have 26 letters");
+    static_assert(alphabet.front() == 'A' && alphabet.back() == 'Z',
+                  "the alphabet must run from A to Z");
+    static_assert(
+        [] {
+            for (std::size_t i{0}; i < size; ++i) {
+                if (alphabet[i] != static_cast<char>('A' + i) ||
+                    index(alphabet[i]) != i || letter(i) != alphabet[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }(),
+        "the alphabet must be the contiguous letters A-Z and the tables must be inverses");
+    static_assert(!contains('a') && !contains('@') && !contains('[') &&
+                      !contains('\0') && !contains('\xFF'),
+                  "only uppercase letters are in the alphabet");
+    static_assert(letter(size + 1) == 'B', "letter() must wrap around");
 }    // namespace Alphabet
 
-#endif    // MPAGSCIPHER_ALPHABET_HPP
\ No newline at end of file
+#endif    // MPAGSCIPHER_ALPHABET_HPP
@@ -1,12 +1,16 @@
 #include "CaesarCipher.hpp"
 #include "Alphabet.hpp"
 #include "Cipher.hpp"
+#include "ShiftKernels.hpp"
 
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
 
 CaesarCipher::CaesarCipher(const std::size_t key) : key_{key % Alphabet::size}
 {
+    this->buildTables();
 }
 
 CaesarCipher::CaesarCipher(const std::string& key) : key_{0}
@@ -54,42 +58,75 @@ CaesarCipher::CaesarCipher(const std::string& key) : key_{0}
 
         key_ = std::stoul(key) % Alphabet::size;
     }
+
+    this->buildTables();
+}
+
+void CaesarCipher::buildTables()
+{
+    // Start from the identity mapping so that any byte not in the alphabet
+    // passes through unchanged
+    for (std::size_t i{0}; i < encryptTable_.size(); ++i) {
+        encryptTable_[i] = static_cast<char>(i);
+        decryptTable_[i] = static_cast<char>(i);
+    }
+
+    // Then overwrite the entries for the letters of the alphabet with the
+    // shifted letters (in each direction)
+    for (std::size_t i{0}; i < Alphabet::size; ++i) {
+        const auto letter = static_cast<unsigned char>(Alphabet::alphabet[i]);
+        encryptTable_[letter] = Alphabet::letter(i + key_);
+        decryptTable_[letter] = Alphabet::letter(i + Alphabet::size - key_);
+    }
 }
 
-std::string CaesarCipher::applyCipher(const std::string& inputText,
+std::size_t CaesarCipher::applyCipher(const TextChunk& chunk,
+                                      char* outputText,
                                       const CipherMode cipherMode) const
 {
-    // Create the output string
-    std::string outputText;
-
-    // Loop over the input text
-    char processedChar{'x'};
-    for (const auto& origChar : inputText) {
-        // For each character in the input text, find the corresponding position in
-        // the alphabet by using an indexed loop over the alphabet container
-        for (std::size_t i{0}; i < Alphabet::size; ++i) {
-            if (origChar == Alphabet::alphabet[i]) {
-                // Apply the appropriate shift (depending on whether we're encrypting
-                // or decrypting) and determine the new character
-                // Can then break out of the loop over the alphabet
-                switch (cipherMode) {
-                    case CipherMode::Encrypt:
-                        processedChar =
-                            Alphabet::alphabet[(i + key_) % Alphabet::size];
-                        break;
-                    case CipherMode::Decrypt:
-                        processedChar =
-                            Alphabet::alphabet[(i + Alphabet::size - key_) %
-                                               Alphabet::size];
-                        break;
-                }
-                break;
-            }
-        }
+    const std::string_view inputText{chunk.text};
+
+    // Select the translation table for the requested mode once,
+    // rather than deciding for every character
+    const TranslationTable& table{
+        (cipherMode == CipherMode::Encrypt) ? encryptTable_ : decryptTable_};
+
+    const std::size_t inputSize{inputText.size()};
+
+    // Process as much of the text as possible with the vectorised kernel,
+    // which needs the shift expressed in the forward direction
+    const std::size_t shift{(cipherMode == CipherMode::Encrypt)
+                                ? key_
+                                : (Alphabet::size - key_) % Alphabet::size};
+    const std::size_t nDone{ShiftKernels::caesarShift(
+        ShiftKernels::activeKernel(), inputText.data(), outputText, inputSize,
+        shift)};
+
+    // Translate each remaining character with a single table lookup
+    for (std::size_t i{nDone}; i < inputSize; ++i) {
+        outputText[i] = table[static_cast<unsigned char>(inputText[i])];
+    }
+
+    return inputSize;
+}
 
-        // Add the new character to the output text
-        outputText += processedChar;
+std::size_t CaesarCipher::applyCipherBatch(
+    const std::string_view messages, const std::vector<std::size_t>& offsets,
+    char* outputText, std::vector<std::size_t>& outputOffsets,
+    const CipherMode cipherMode) const
+{
+    outputOffsets.resize(offsets.size());
+    if (offsets.empty()) {
+        return 0;
     }
 
-    return outputText;
+    // Every result is the same length as its message, so the results sit
+    // at the same places in the output as the messages do in the input
+    const std::size_t start{offsets.front()};
+    for (std::size_t i{0}; i < offsets.size(); ++i) {
+        outputOffsets[i] = offsets[i] - start;
+    }
+    return this->applyCipher(
+        TextChunk{messages.substr(start, offsets.back() - start), 0},
+        outputText, cipherMode);
 }
@@ -3,9 +3,12 @@
 
 #include "Cipher.hpp"
 #include "CipherMode.hpp"
+#include "TextChunk.hpp"
 
+#include <array>
 #include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -33,19 +36,75 @@ class CaesarCipher : public Cipher {
      */
     explicit CaesarCipher(const std::string& key);
 
+    /// Make the std::string version of applyCipher from the base class visible
+    using Cipher::applyCipher;
+
     /**
-     * \brief Apply the cipher to the provided text
+     * \brief Apply the cipher to a chunk of text, writing the result into the provided buffer
      *
-     * \param inputText the text to encrypt or decrypt
+     * \param chunk the text to encrypt or decrypt, and its offset within the whole text
+     * \param outputText where to write the result, which must have room for
+     *                   outputSize(chunk.text) characters
      * \param cipherMode whether to encrypt or decrypt the input text
-     * \return the result of applying the cipher to the input text
+     * \return the number of characters written to the output
      */
-    std::string applyCipher(const std::string& inputText,
+    std::size_t applyCipher(const TextChunk& chunk, char* outputText,
                             const CipherMode cipherMode) const override;
 
+    /**
+     * \brief Apply the cipher separately to each of a batch of messages, writing all the results into one buffer
+     *
+     * Since each character is shifted independently, the whole buffer of
+     * messages is ciphered with a single pass of the shift kernel
+     *
+     * \param messages the messages, stored one after another
+     * \param offsets where each message starts in messages, followed by where the last one ends
+     * \param outputText where to write the results, which must have room for
+     *                   batchOutputSize(offsets) characters
+     * \param outputOffsets set to where each result starts in outputText,
+     *                      followed by where the last one ends
+     * \param cipherMode whether to encrypt or decrypt the messages
+     * \return the total number of characters written to the output
+     */
+    std::size_t applyCipherBatch(const std::string_view messages,
+                                 const std::vector<std::size_t>& offsets,
+                                 char* outputText,
+                                 std::vector<std::size_t>& outputOffsets,
+                                 const CipherMode cipherMode) const override;
+
+    /**
+     * \brief Each character is shifted independently, so the text can be chunked
+     *
+     * \return true
+     */
+    bool supportsChunking() const override { return true; }
+
+    /**
+     * \brief Each character is replaced by exactly one character, so the cipher can be applied in place
+     *
+     * \return true
+     */
+    bool preservesLength() const override { return true; }
+
   private:
+    /// Type definition for a table translating every possible byte value
+    using TranslationTable = std::array<char, 256>;
+
     /// The cipher key, essentially a constant shift to be applied
     std::size_t key_{0};
+
+    /// Lookup table to go from a plaintext byte to the ciphertext byte
+    TranslationTable encryptTable_{};
+
+    /// Lookup table to go from a ciphertext byte to the plaintext byte
+    TranslationTable decryptTable_{};
+
+    /**
+     * \brief Fill the encrypt and decrypt translation tables for the current key
+     *
+     * Bytes that are not in the alphabet are mapped onto themselves
+     */
+    void buildTables();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,119 @@
+#include "CaesarCracker.hpp"
+#include "Alphabet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /// The number of separate tables the bytes are counted into
+    const std::size_t nTables{4};
+}    // namespace
+
+namespace CaesarCracker {
+    LetterCounts countLetters(const std::string_view text)
+    {
+        // Count every byte value, spreading consecutive bytes over several
+        // tables so that runs of the same letter do not each have to wait
+        // for the previous increment of the same counter to finish
+        std::array<std::array<std::uint64_t, 256>, nTables> tables{};
+        const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+        const std::size_t size{text.size()};
+        std::size_t i{0};
+        for (; i + nTables <= size; i += nTables) {
+            ++tables[0][bytes[i]];
+            ++tables[1][bytes[i + 1]];
+            ++tables[2][bytes[i + 2]];
+            ++tables[3][bytes[i + 3]];
+        }
+        for (; i < size; ++i) {
+            ++tables[0][bytes[i]];
+        }
+
+        // Then keep only the letters of the alphabet
+        LetterCounts counts{};
+        for (std::size_t letter{0}; letter < Alphabet::size; ++letter) {
+            const auto byte =
+                static_cast<unsigned char>(Alphabet::alphabet[letter]);
+            for (const auto& table : tables) {
+                counts[letter] += table[byte];
+            }
+        }
+        return counts;
+    }
+
+    LetterCounts countLetters(const std::string_view text, ThreadPool& pool)
+    {
+        // Not worth handing small texts to the pool
+        const std::size_t minChunkSize{1 << 16};
+        const std::size_t nChunks{
+            std::min(pool.size(), text.size() / minChunkSize)};
+        if (nChunks <= 1) {
+            return countLetters(text);
+        }
+
+        // Count each chunk separately and add up the results
+        const std::size_t chunkSize{(text.size() + nChunks - 1) / nChunks};
+        std::vector<std::future<LetterCounts>> futures;
+        futures.reserve(nChunks);
+        for (std::size_t start{0}; start < text.size(); start += chunkSize) {
+            const std::string_view chunk{text.substr(start, chunkSize)};
+            futures.push_back(
+                pool.submit([chunk] { return countLetters(chunk); }));
+        }
+
+        LetterCounts counts{};
+        for (auto& future : futures) {
+            const LetterCounts chunkCounts{future.get()};
+            for (std::size_t letter{0}; letter < Alphabet::size; ++letter) {
+                counts[letter] += chunkCounts[letter];
+            }
+        }
+        return counts;
+    }
+
+    CrackResult scoreKeys(const LetterCounts& counts)
+    {
+        CrackResult result{0, {}, 0};
+        for (const auto count : counts) {
+            result.nLetters += count;
+        }
+
+        // Decrypting with a key k turns each letter i of the plaintext back
+        // from letter i + k of the ciphertext, so compare the count of that
+        // letter with how often letter i appears in English
+        const auto nLetters = static_cast<double>(result.nLetters);
+        double bestScore{std::numeric_limits<double>::max()};
+        for (std::size_t key{0}; key < Alphabet::size; ++key) {
+            double chiSquared{0.0};
+            for (std::size_t letter{0}; letter < Alphabet::size; ++letter) {
+                const double expected{englishFrequencies[letter] * nLetters};
+                const auto observed = static_cast<double>(
+                    counts[(letter + key) % Alphabet::size]);
+                const double difference{observed - expected};
+                if (expected > 0.0) {
+                    chiSquared += difference * difference / expected;
+                }
+            }
+            result.chiSquared[key] = chiSquared;
+            if (chiSquared < bestScore) {
+                bestScore = chiSquared;
+                result.key = key;
+            }
+        }
+        return result;
+    }
+
+    CrackResult crack(const std::string_view text, ThreadPool& pool,
+                      const std::size_t sampleSize)
+    {
+        const std::string_view sample{
+            (sampleSize == 0) ? text : text.substr(0, sampleSize)};
+        return scoreKeys(countLetters(sample, pool));
+    }
+}    // namespace CaesarCracker
@@ -0,0 +1,94 @@
+#ifndef MPAGSCIPHER_CAESARCRACKER_HPP
+#define MPAGSCIPHER_CAESARCRACKER_HPP
+
+#include "Alphabet.hpp"
+#include "ThreadPool.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * \file CaesarCracker.hpp
+ * \brief Contains the declarations of the functions for recovering the key of Caesar-enciphered text
+ */
+
+/**
+ * \namespace CaesarCracker
+ * \brief Namespace to hold the frequency analysis used to find the key of Caesar-enciphered text
+ *
+ * The letters of the text are counted once, and then every possible key is
+ * scored by how closely the letter counts it would decrypt to match those
+ * of English, so only one pass over the text is needed rather than one
+ * decryption per key.
+ *
+ * It can be used as follows:
+ * \code{.cpp}
+ * ThreadPool pool;
+ * const CaesarCracker::CrackResult result{CaesarCracker::crack(cipherText, pool)};
+ * CaesarCipher cipher{result.key};
+ * \endcode
+ */
+namespace CaesarCracker {
+    /// Type definition for the number of times each letter of the alphabet appears
+    using LetterCounts = std::array<std::uint64_t, Alphabet::size>;
+
+    /// The relative frequency of each letter in English text
+    inline constexpr std::array<double, Alphabet::size> englishFrequencies{
+        0.08167, 0.01492, 0.02782, 0.04253, 0.12702, 0.02228, 0.02015,
+        0.06094, 0.06966, 0.00153, 0.00772, 0.04025, 0.02406, 0.06749,
+        0.07507, 0.01929, 0.00095, 0.05987, 0.06327, 0.09056, 0.02758,
+        0.00978, 0.02360, 0.00150, 0.01974, 0.00074};
+
+    /**
+     * \struct CrackResult
+     * \brief The key found for a text, and how well each possible key scored
+     */
+    struct CrackResult {
+        /// The most likely key
+        std::size_t key;
+        /// The chi-squared statistic for each key, lower meaning closer to English
+        std::array<double, Alphabet::size> chiSquared;
+        /// The number of letters the result is based on
+        std::uint64_t nLetters;
+    };
+
+    /**
+     * \brief Count how many times each letter of the alphabet appears in the text
+     *
+     * \param text the text, in which anything that is not a letter of the alphabet is ignored
+     * \return the count for each letter
+     */
+    LetterCounts countLetters(const std::string_view text);
+
+    /**
+     * \brief Count how many times each letter of the alphabet appears in the text, sharing the work between the threads of the pool
+     *
+     * \param text the text, in which anything that is not a letter of the alphabet is ignored
+     * \param pool the workers to use
+     * \return the count for each letter
+     */
+    LetterCounts countLetters(const std::string_view text, ThreadPool& pool);
+
+    /**
+     * \brief Score every possible key against the letter counts of a text
+     *
+     * \param counts the number of times each letter appears in the enciphered text
+     * \return the key giving the letter frequencies closest to English, and the score for each key
+     */
+    CrackResult scoreKeys(const LetterCounts& counts);
+
+    /**
+     * \brief Find the most likely key for a Caesar-enciphered text
+     *
+     * \param text the enciphered text
+     * \param pool the workers to use when counting the letters
+     * \param sampleSize if not zero, only the first sampleSize characters of the text are looked at
+     * \return the most likely key, and the score for each key
+     */
+    CrackResult crack(const std::string_view text, ThreadPool& pool,
+                      const std::size_t sampleSize = 0);
+}    // namespace CaesarCracker
+
+#endif    // MPAGSCIPHER_CAESARCRACKER_HPP
@@ -2,12 +2,28 @@
 #define MPAGSCIPHER_CIPHER_HPP
 
 #include "CipherMode.hpp"
+#include "TextChunk.hpp"
 
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
+class CipherContext;
+class ThreadPool;
+
+/**
+ * \class InPlaceNotSupported
+ * \brief Exception thrown when asking a cipher that changes the length of the text to work in place
+ */
+class InPlaceNotSupported : public std::invalid_argument {
+  public:
+    InPlaceNotSupported(const std::string& what) : std::invalid_argument(what)
+    {
+    }
+};
+
 /**
  * \file Cipher.hpp
  * \brief Contains the declaration of the purely abstract Cipher base class
@@ -29,49 +45,217 @@ class Cipher {
     /**
      * \brief Apply the cipher to the provided text
      *
+     * By default this allocates the output and calls the overload that
+     * writes into a caller-provided buffer
+     *
      * \param inputText the text to encrypt or decrypt
      * \param cipherMode whether to encrypt or decrypt the input text
      * \return the result of applying the cipher to the input text
      */
     virtual std::string applyCipher(const std::string& inputText,
+                                    const CipherMode cipherMode) const
+    {
+        std::string outputText(this->outputSize(inputText), '\0');
+        outputText.resize(this->applyCipher(TextChunk{inputText, 0},
+                                            outputText.data(), cipherMode));
+        return outputText;
+    }
+
+    /**
+     * \brief Apply the cipher to a chunk of text, writing the result into the provided buffer
+     *
+     * \param chunk the text to encrypt or decrypt, and its offset within the whole text
+     * \param outputText where to write the result, which must have room for
+     *                   outputSize(chunk.text) characters (if preservesLength()
+     *                   this may be the start of the chunk itself)
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the number of characters written to the output
+     */
+    virtual std::size_t applyCipher(const TextChunk& chunk, char* outputText,
                                     const CipherMode cipherMode) const = 0;
 
     /**
-     * \brief split input text into substrings, each substring gets processed by a different thread
+     * \brief Whether the cipher produces exactly one output character for each input character
+     *
+     * If true, the result for each character can be written over the
+     * character itself, so the cipher can be applied in place
+     *
+     * \return true if the result is always the same length as the input
+     */
+    virtual bool preservesLength() const { return false; }
+
+    /**
+     * \brief Apply the cipher to text held in a buffer, overwriting it with the result
+     *
+     * No memory is allocated, so this can be used on buffers that the
+     * caller already owns, such as mapped files
+     *
+     * \param text the text to encrypt or decrypt, which is replaced by the result
+     * \param size the number of characters in the text
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \param offset the position of the text within the whole text it is part of
+     * \exception InPlaceNotSupported if the cipher does not preserve the length of the text
+     */
+    void applyCipherInPlace(char* text, const std::size_t size,
+                            const CipherMode cipherMode,
+                            const std::size_t offset = 0) const
+    {
+        if (!this->preservesLength()) {
+            throw InPlaceNotSupported(
+                "cipher changes the length of the text so cannot be applied in place");
+        }
+        this->applyCipher(TextChunk{std::string_view{text, size}, offset}, text,
+                          cipherMode);
+    }
+
+    /**
+     * \brief Apply the cipher separately to each of a batch of messages, writing all the results into one buffer
+     *
+     * Each message is treated as a whole text of its own, but the whole
+     * batch is handled in a single call, with no memory allocated for each
+     * message, so the cost of the call and of setting up the key is shared
+     * between them.
+     * By default the messages are ciphered one after another; ciphers that
+     * can do better (e.g. by ciphering the whole buffer at once) override this.
+     *
+     * \param messages the messages, stored one after another
+     * \param offsets where each message starts in messages, followed by where
+     *                the last one ends (so one more entry than there are messages)
+     * \param outputText where to write the results, which must have room for
+     *                   batchOutputSize(offsets) characters
+     * \param outputOffsets set to where each result starts in outputText,
+     *                      followed by where the last one ends
+     * \param cipherMode whether to encrypt or decrypt the messages
+     * \return the total number of characters written to the output
+     */
+    virtual std::size_t applyCipherBatch(
+        const std::string_view messages, const std::vector<std::size_t>& offsets,
+        char* outputText, std::vector<std::size_t>& outputOffsets,
+        const CipherMode cipherMode) const
+    {
+        outputOffsets.resize(offsets.size());
+        std::size_t nWritten{0};
+        for (std::size_t i{0}; i + 1 < offsets.size(); ++i) {
+            outputOffsets[i] = nWritten;
+            nWritten += this->applyCipher(
+                TextChunk{messages.substr(offsets[i], offsets[i + 1] - offsets[i]),
+                          0},
+                outputText + nWritten, cipherMode);
+        }
+        if (!offsets.empty()) {
+            outputOffsets.back() = nWritten;
+        }
+        return nWritten;
+    }
+
+    /**
+     * \brief The most characters that applying the cipher to a batch of messages can produce
+     *
+     * \param offsets where each message starts, followed by where the last one ends
+     * \return an upper bound on the total size of the results, for sizing the output of applyCipherBatch
+     */
+    std::size_t batchOutputSize(const std::vector<std::size_t>& offsets) const
+    {
+        std::size_t outputSize{0};
+        for (std::size_t i{0}; i + 1 < offsets.size(); ++i) {
+            outputSize += this->maxOutputSize(offsets[i + 1] - offsets[i]);
+        }
+        return outputSize;
+    }
+
+    /**
+     * \brief The number of characters produced by applying the cipher to the provided text
+     *
+     * \param inputText the text to be encrypted or decrypted
+     * \return the size of the result of applying the cipher
+     */
+    virtual std::size_t outputSize(const std::string_view inputText) const
+    {
+        return inputText.size();
+    }
+
+    /**
+     * \brief The most characters that applying the cipher to a text of the given length can produce
+     *
+     * Unlike outputSize this does not need to look at the text, so it can be
+     * used to size a buffer before the text is known
+     *
+     * \param inputSize the length of the text to be encrypted or decrypted
+     * \return an upper bound on the size of the result of applying the cipher
+     */
+    virtual std::size_t maxOutputSize(const std::size_t inputSize) const
+    {
+        return inputSize;
+    }
+
+    /**
+     * \brief The length of the start of the text that can be ciphered without seeing what follows it
+     *
+     * Used when the text arrives in pieces: only this much of what has
+     * been read so far is passed to the cipher, the rest being held back
+     * until more of the text (or its end) arrives.
+     * By default every character can be ciphered on its own.
+     *
+     * \param inputText the text read so far that has not yet been ciphered
+     * \return the number of characters at the start of the text that can be ciphered now
+     */
+    virtual std::size_t completeLength(const std::string_view inputText) const
+    {
+        return inputText.size();
+    }
+
+    /**
+     * \brief Whether the cipher can be applied to separate chunks of the text independently
+     *
+     * If true, applying the cipher to consecutive pieces of a text (each with
+     * its offset in the whole text) and joining the results gives the same
+     * result as applying it to the whole text, so the pieces can be
+     * processed in parallel
+     *
+     * \return true if the text can be split into chunks for this cipher
+     */
+    virtual bool supportsChunking() const { return false; }
+
+    /**
+     * \brief split input text into chunks, each chunk gets processed by a different thread
+     *
+     * The chunks are views into the original text, so no characters are
+     * copied and the text must outlive them.
+     * Each chunk records its offset in the text.
+     * Ciphers that need the chunk boundaries to fall at particular places
+     * can override this to move them.
      *
      * \param str the text to be split up
      * \param n number of threads
+     * \return the consecutive, non-overlapping chunks, at most n of them
      */
-    std::vector <std::string> splitString(std::string str, int n)
+    virtual std::vector<TextChunk> splitString(const std::string_view str,
+                                               const std::size_t n) const
     {
-     int str_length = str.size();
-     int part_size = str_length / n; // length of each substring
-     std::vector <std::string> substrings{};
-
-
-     for (int i = 0; i < str_length; i= i+part_size)
-     {
-       if (str_length % n != 0) // can't divide into equal parts
-       {
-         if( i + part_size >=  str_length ) // end of the string
-         {
-           substrings.push_back(str.substr(i,str_length-1));
-         }
-         else
-         {
-           substrings.push_back(str.substr(i,i+part_size));
-         }
-       }
-       else // can be equally divided
-       {
-         substrings.push_back(str.substr(i,i+part_size));
-       }
-     }
-
-     return substrings;
-    }
+        const std::size_t str_length{str.size()};
+        // length of each chunk, rounded up so that
+        // we never need more than n of them
+        const std::size_t part_size{(n == 0) ? str_length
+                                             : (str_length + n - 1) / n};
+        std::vector<TextChunk> chunks{};
 
+        for (std::size_t i{0}; i < str_length; i += part_size) {
+            // the final chunk may be shorter than the others
+            chunks.push_back(TextChunk{str.substr(i, part_size), i});
+        }
 
+        return chunks;
+    }
+
+    /**
+     * \brief Create a context for applying the cipher to a text that arrives in pieces
+     *
+     * \param cipherMode whether to encrypt or decrypt the text
+     * \param pool if not null, the workers to share the work on each piece between
+     * \return the new context, which refers to (and so must not outlive) this cipher
+     */
+    CipherContext makeContext(const CipherMode cipherMode,
+                              ThreadPool* pool = nullptr) const;
 
     /// Default constructor
     Cipher() = default;
@@ -0,0 +1,93 @@
+#include "CipherCache.hpp"
+#include "CipherFactory.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+CipherCache::CipherCache(const std::size_t capacity, const std::size_t nShards)
+    : shardCapacity_{0}, shards_(nShards == 0 ? 1 : nShards)
+{
+    // Share the capacity out between the shards, rounding up so that
+    // every shard can hold at least one cipher
+    const std::size_t n{shards_.size()};
+    shardCapacity_ = (capacity == 0) ? 1 : (capacity + n - 1) / n;
+}
+
+std::size_t CipherCache::CacheKeyHash::operator()(
+    const CacheKey& cacheKey) const
+{
+    // Mix the type into the hash of the key so that the same key for
+    // different ciphers lands in different places
+    const std::size_t keyHash{std::hash<std::string>{}(cacheKey.second)};
+    const auto typeHash = static_cast<std::size_t>(cacheKey.first);
+    const auto goldenRatio = static_cast<std::size_t>(0x9e3779b97f4a7c15ull);
+    return keyHash ^
+           (typeHash + goldenRatio + (keyHash << 6) + (keyHash >> 2));
+}
+
+std::shared_ptr<const Cipher> CipherCache::get(const CipherType type,
+                                               const std::string& key)
+{
+    CacheKey cacheKey{type, key};
+    const std::size_t hash{CacheKeyHash{}(cacheKey)};
+    // Use the high bits for the shard, since the unordered_map inside
+    // the shard uses the low ones
+    const std::size_t highBits{hash >> (4 * sizeof(std::size_t))};
+    Shard& shard{shards_[highBits % shards_.size()]};
+
+    {
+        const std::lock_guard<std::mutex> lock{shard.mutex};
+        const auto found = shard.index.find(cacheKey);
+        if (found != shard.index.end()) {
+            // Move it to the front, as the most recently used
+            shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return found->second->second;
+        }
+    }
+
+    // Set up the cipher without holding the lock, since that is the slow
+    // part and other threads may want other keys from this shard meanwhile
+    // (an invalid key throws from here, so nothing is cached for it)
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    std::shared_ptr<const Cipher> cipher{cipherFactory(type, key)};
+
+    const std::lock_guard<std::mutex> lock{shard.mutex};
+    const auto found = shard.index.find(cacheKey);
+    if (found != shard.index.end()) {
+        // Another thread made the same cipher while we were making ours,
+        // so use theirs so that everyone shares one instance
+        shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+        return found->second->second;
+    }
+    if (shard.lru.size() >= shardCapacity_) {
+        shard.index.erase(shard.lru.back().first);
+        shard.lru.pop_back();
+    }
+    shard.lru.emplace_front(std::move(cacheKey), cipher);
+    shard.index.emplace(shard.lru.front().first, shard.lru.begin());
+    return cipher;
+}
+
+std::size_t CipherCache::size() const
+{
+    std::size_t nCached{0};
+    for (const auto& shard : shards_) {
+        const std::lock_guard<std::mutex> lock{shard.mutex};
+        nCached += shard.lru.size();
+    }
+    return nCached;
+}
+
+void CipherCache::clear()
+{
+    for (auto& shard : shards_) {
+        const std::lock_guard<std::mutex> lock{shard.mutex};
+        shard.index.clear();
+        shard.lru.clear();
+    }
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+}
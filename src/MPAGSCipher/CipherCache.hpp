@@ -0,0 +1,144 @@
+#ifndef MPAGSCIPHER_CIPHERCACHE_HPP
+#define MPAGSCIPHER_CIPHERCACHE_HPP
+
+#include "Cipher.hpp"
+#include "CipherType.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * \file CipherCache.hpp
+ * \brief Contains the declaration of the CipherCache class
+ */
+
+/**
+ * \class CipherCache
+ * \brief A thread-safe cache of constructed ciphers, so that keys that recur are only set up once
+ *
+ * Ciphers are looked up by their type and key, and made with cipherFactory
+ * when they are not already present.
+ * The cached ciphers are shared and cannot be changed, so any number of
+ * threads can use the same one at once.
+ * The cache is split into shards, each with its own lock, so that threads
+ * looking up different keys rarely wait for each other.
+ * When a shard is full the cipher that was used least recently is dropped
+ * (though it lives on for as long as anyone still holds it).
+ *
+ * It can be used as follows:
+ * \code{.cpp}
+ * CipherCache cache{4096};
+ * const auto cipher = cache.get(CipherType::Playfair, "hello");
+ * std::string outputText{cipher->applyCipher(inputText, CipherMode::Encrypt)};
+ * \endcode
+ */
+class CipherCache {
+  public:
+    /**
+     * \brief Create a new, empty CipherCache
+     *
+     * \param capacity the most ciphers to hold (shared out between the shards)
+     * \param nShards the number of separately locked parts to split the cache into
+     */
+    explicit CipherCache(const std::size_t capacity = 1024,
+                         const std::size_t nShards = 16);
+
+    /// Copying the cache (with its locks) makes no sense, so forbid it
+    CipherCache(const CipherCache& rhs) = delete;
+    /// Nor can the cache be moved
+    CipherCache(CipherCache&& rhs) = delete;
+    /// Copying the cache (with its locks) makes no sense, so forbid it
+    CipherCache& operator=(const CipherCache& rhs) = delete;
+    /// Nor can the cache be moved
+    CipherCache& operator=(CipherCache&& rhs) = delete;
+
+    /**
+     * \brief Get the cipher of the given type with the given key, making it if it is not in the cache
+     *
+     * \param type the concrete type of cipher
+     * \param key the key for the cipher
+     * \return the shared cipher
+     * \exception InvalidKey if the cipher had to be made and the key is not valid for it
+     */
+    std::shared_ptr<const Cipher> get(const CipherType type,
+                                      const std::string& key);
+
+    /**
+     * \brief Get the number of lookups that found the cipher already in the cache
+     *
+     * \return the number of hits
+     */
+    std::uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+
+    /**
+     * \brief Get the number of lookups that had to make the cipher
+     *
+     * \return the number of misses
+     */
+    std::uint64_t misses() const
+    {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Get the number of ciphers currently held
+     *
+     * \return the number of cached ciphers
+     */
+    std::size_t size() const;
+
+    /**
+     * \brief Get the most ciphers that can be held
+     *
+     * \return the capacity, which is rounded up to fill every shard equally
+     */
+    std::size_t capacity() const { return shardCapacity_ * shards_.size(); }
+
+    /// Drop every cached cipher and reset the counters
+    void clear();
+
+  private:
+    /// Type definition for what the ciphers are looked up by
+    using CacheKey = std::pair<CipherType, std::string>;
+
+    /// Hash function for the cache keys
+    struct CacheKeyHash {
+        std::size_t operator()(const CacheKey& cacheKey) const;
+    };
+
+    /// Type definition for the list of cached ciphers, most recently used first
+    using LruList =
+        std::list<std::pair<CacheKey, std::shared_ptr<const Cipher>>>;
+
+    /// One separately locked part of the cache
+    struct Shard {
+        /// Protects the list and the index
+        mutable std::mutex mutex;
+        /// The cached ciphers, most recently used first
+        LruList lru;
+        /// Where each key's cipher is in the list
+        std::unordered_map<CacheKey, LruList::iterator, CacheKeyHash> index;
+    };
+
+    /// The most ciphers each shard can hold
+    std::size_t shardCapacity_;
+
+    /// The shards
+    std::vector<Shard> shards_;
+
+    /// The number of lookups that found the cipher in the cache
+    std::atomic<std::uint64_t> hits_{0};
+
+    /// The number of lookups that had to make the cipher
+    std::atomic<std::uint64_t> misses_{0};
+};
+
+#endif    // MPAGSCIPHER_CIPHERCACHE_HPP
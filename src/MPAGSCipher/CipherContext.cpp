@@ -0,0 +1,70 @@
+#include "CipherContext.hpp"
+#include "Instrumentation.hpp"
+#include "ParallelCipher.hpp"
+#include "TextChunk.hpp"
+
+CipherContext Cipher::makeContext(const CipherMode cipherMode,
+                                  ThreadPool* pool) const
+{
+    return CipherContext{*this, cipherMode, pool};
+}
+
+CipherContext::CipherContext(const Cipher& cipher, const CipherMode cipherMode,
+                             ThreadPool* pool)
+    : cipher_{cipher}, cipherMode_{cipherMode}, pool_{pool}
+{
+}
+
+std::size_t CipherContext::outputBound(const std::size_t inputSize) const
+{
+    return cipher_.maxOutputSize(pendingText_.size() + inputSize);
+}
+
+std::size_t CipherContext::update(const std::string_view inputText,
+                                  char* outputText)
+{
+    // If nothing was held back last time, cipher straight from the input
+    // and only copy what has to be held back this time
+    if (pendingText_.empty()) {
+        const std::size_t nComplete{cipher_.completeLength(inputText)};
+        const std::size_t nWritten{
+            this->apply(inputText.substr(0, nComplete), outputText)};
+        pendingText_.assign(inputText.substr(nComplete));
+        return nWritten;
+    }
+
+    pendingText_.append(inputText);
+    const std::size_t nComplete{cipher_.completeLength(pendingText_)};
+    const std::size_t nWritten{this->apply(
+        std::string_view{pendingText_}.substr(0, nComplete), outputText)};
+    pendingText_.erase(0, nComplete);
+    return nWritten;
+}
+
+std::size_t CipherContext::finalize(char* outputText)
+{
+    const std::size_t nWritten{this->apply(pendingText_, outputText)};
+    pendingText_.clear();
+    offset_ = 0;
+    return nWritten;
+}
+
+std::size_t CipherContext::apply(const std::string_view inputText,
+                                 char* outputText)
+{
+    if (inputText.empty()) {
+        return 0;
+    }
+    const TextChunk chunk{inputText, offset_};
+    offset_ += inputText.size();
+    if (pool_) {
+        return applyCipherParallel(cipher_, chunk, outputText, cipherMode_,
+                                   *pool_);
+    }
+    Instrumentation::StageTimer timer{Instrumentation::Stage::Cipher,
+                                      inputText.size()};
+    const std::size_t nWritten{
+        cipher_.applyCipher(chunk, outputText, cipherMode_)};
+    timer.setBytesOut(nWritten);
+    return nWritten;
+}
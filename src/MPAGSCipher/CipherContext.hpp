@@ -0,0 +1,98 @@
+#ifndef MPAGSCIPHER_CIPHERCONTEXT_HPP
+#define MPAGSCIPHER_CIPHERCONTEXT_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * \file CipherContext.hpp
+ * \brief Contains the declaration of the CipherContext class
+ */
+
+/**
+ * \class CipherContext
+ * \brief Applies a cipher to a text that is provided a piece at a time
+ *
+ * Holds the state needed to carry on from one piece of the text to the
+ * next: the position in the whole text (for the Vigenere key) and any
+ * characters that cannot be ciphered until more of the text is seen (such
+ * as the unpaired letter at the end of a piece for the Playfair cipher).
+ * Joining the output of every call to update() followed by that of
+ * finalize() gives the same result as applying the cipher to the whole
+ * text at once.
+ *
+ * It can be used as follows:
+ * \code{.cpp}
+ * CipherContext context{cipher.makeContext(CipherMode::Encrypt)};
+ * std::vector<char> output(context.outputBound(piece.size()));
+ * std::size_t nWritten{context.update(piece, output.data())};
+ * ...
+ * nWritten = context.finalize(output.data());
+ * \endcode
+ */
+class CipherContext {
+  public:
+    /**
+     * \brief Create a new context for applying the cipher to a text from the start
+     *
+     * \param cipher the cipher to apply, which must outlive the context
+     * \param cipherMode whether to encrypt or decrypt the text
+     * \param pool if not null, the workers to share the work on each piece between
+     */
+    CipherContext(const Cipher& cipher, const CipherMode cipherMode,
+                  ThreadPool* pool = nullptr);
+
+    /**
+     * \brief The most characters that a call to update() with this much input, or to finalize(), can write
+     *
+     * \param inputSize the length of the next piece of text, zero for finalize()
+     * \return the size of output buffer needed
+     */
+    std::size_t outputBound(const std::size_t inputSize) const;
+
+    /**
+     * \brief Apply the cipher to the next piece of the text
+     *
+     * Some of the input may be held back until the next call to update()
+     * or finalize(), so fewer characters than expected may be written.
+     *
+     * \param inputText the next piece of the (already transliterated) text
+     * \param outputText where to write the result, which must have room
+     *                   for outputBound(inputText.size()) characters
+     * \return the number of characters written to the output
+     */
+    std::size_t update(const std::string_view inputText, char* outputText);
+
+    /**
+     * \brief Apply the cipher to whatever is left of the text now that it has ended
+     *
+     * The context is then reset, ready to be used for another text.
+     *
+     * \param outputText where to write the result, which must have room
+     *                   for outputBound(0) characters
+     * \return the number of characters written to the output
+     */
+    std::size_t finalize(char* outputText);
+
+  private:
+    /// The cipher to apply
+    const Cipher& cipher_;
+    /// Whether to encrypt or decrypt the text
+    CipherMode cipherMode_;
+    /// The workers to share the work between, if any
+    ThreadPool* pool_;
+    /// The characters that have been provided but not yet ciphered
+    std::string pendingText_;
+    /// The position in the whole text of the first pending character
+    std::size_t offset_{0};
+
+    /// Cipher the given text, which starts at the current offset
+    std::size_t apply(const std::string_view inputText, char* outputText);
+};
+
+#endif    // MPAGSCIPHER_CIPHERCONTEXT_HPP
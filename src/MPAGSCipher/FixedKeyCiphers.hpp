@@ -0,0 +1,305 @@
+#ifndef MPAGSCIPHER_FIXEDKEYCIPHERS_HPP
+#define MPAGSCIPHER_FIXEDKEYCIPHERS_HPP
+
+#include "Alphabet.hpp"
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "ShiftKernels.hpp"
+#include "TextChunk.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * \file FixedKeyCiphers.hpp
+ * \brief Contains the declarations of the Caesar and Vigenere ciphers specialised at compile time for a fixed key
+ *
+ * When the key is known when the program is built, the shifts become
+ * constants, so the compiler can fold them into the loops, unroll the
+ * loop over the key and vectorise the result, rather than looking the
+ * shifts up as the runtime-keyed ciphers must.
+ * They give exactly the same results as CaesarCipher and VigenereCipher
+ * with the same key, and can be used wherever a Cipher is expected.
+ */
+
+// When building for x86 with a compiler that lets us enable instruction
+// sets per-function, the loops are also compiled for AVX2, and that copy is
+// used whenever ShiftKernels has selected its AVX2 kernel
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MPAGSCIPHER_FIXEDKEY_AVX2
+#define MPAGSCIPHER_FIXEDKEY_INLINE __attribute__((always_inline)) inline
+#else
+#define MPAGSCIPHER_FIXEDKEY_INLINE inline
+#endif
+
+/**
+ * \brief Shift a character forward around the alphabet, leaving anything that is not a letter unchanged
+ *
+ * Written without a lookup so that, with a constant shift, loops over it vectorise
+ *
+ * \param c the character to shift
+ * \param shift the number of places to shift by, less than the size of the alphabet
+ * \return the shifted character
+ */
+MPAGSCIPHER_FIXEDKEY_INLINE constexpr char shiftLetter(const char c,
+                                                       const std::uint8_t shift)
+{
+    // Everything is kept to (signed) bytes, and the choices made with
+    // arithmetic rather than branches, so that the compiler can keep many
+    // characters in one vector register and use the same byte comparisons
+    // as the hand-written kernels
+    const auto sc = static_cast<std::int8_t>(c);
+    const bool isLetter{sc >= 'A' && sc <= 'Z'};
+    const auto shifted = static_cast<std::int8_t>(sc + shift);
+    const auto wrapped = static_cast<std::int8_t>(
+        (shifted > 'Z') ? shifted - static_cast<int>(Alphabet::size) : shifted);
+    return static_cast<char>(isLetter ? wrapped : sc);
+}
+
+/**
+ * \class CaesarKernel
+ * \brief Encrypt or decrypt text using the Caesar cipher with a key fixed at compile time
+ *
+ * It can be used as follows:
+ * \code{.cpp}
+ * const CaesarKernel<13> rot13;
+ * std::string outputText{rot13.applyCipher(inputText, CipherMode::Encrypt)};
+ * \endcode
+ *
+ * \tparam Key the cipher key, the constant shift to be applied
+ */
+template <std::size_t Key>
+class CaesarKernel : public Cipher {
+  public:
+    /// Make the std::string version of applyCipher from the base class visible
+    using Cipher::applyCipher;
+
+    /// The shift applied when encrypting
+    static constexpr std::uint8_t encryptShift{Key % Alphabet::size};
+
+    /// The shift applied when decrypting
+    static constexpr std::uint8_t decryptShift{
+        (Alphabet::size - encryptShift) % Alphabet::size};
+
+    /**
+     * \brief Apply the cipher to a chunk of text, writing the result into the provided buffer
+     *
+     * \param chunk the text to encrypt or decrypt, and its offset within the whole text
+     * \param outputText where to write the result, which must have room for
+     *                   outputSize(chunk.text) characters
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the number of characters written to the output
+     */
+    std::size_t applyCipher(const TextChunk& chunk, char* outputText,
+                            const CipherMode cipherMode) const override
+    {
+        // Choose the mode once, so that each loop has a constant shift
+#ifdef MPAGSCIPHER_FIXEDKEY_AVX2
+        if (ShiftKernels::activeKernel() == ShiftKernels::Kernel::AVX2) {
+            if (cipherMode == CipherMode::Encrypt) {
+                shiftTextAVX2<encryptShift>(chunk.text, outputText);
+            } else {
+                shiftTextAVX2<decryptShift>(chunk.text, outputText);
+            }
+            return chunk.text.size();
+        }
+#endif
+        if (cipherMode == CipherMode::Encrypt) {
+            shiftText<encryptShift>(chunk.text, outputText);
+        } else {
+            shiftText<decryptShift>(chunk.text, outputText);
+        }
+        return chunk.text.size();
+    }
+
+    /**
+     * \brief Each character is shifted independently, so the text can be chunked
+     *
+     * \return true
+     */
+    bool supportsChunking() const override { return true; }
+
+    /**
+     * \brief Each character is replaced by exactly one character, so the cipher can be applied in place
+     *
+     * \return true
+     */
+    bool preservesLength() const override { return true; }
+
+  private:
+    /// Shift every letter of the text by the constant Shift
+    template <std::uint8_t Shift>
+    static MPAGSCIPHER_FIXEDKEY_INLINE void shiftText(
+        const std::string_view inputText, char* outputText)
+    {
+        const std::size_t inputSize{inputText.size()};
+        for (std::size_t i{0}; i < inputSize; ++i) {
+            outputText[i] = shiftLetter(inputText[i], Shift);
+        }
+    }
+
+#ifdef MPAGSCIPHER_FIXEDKEY_AVX2
+    /// The same loop, compiled to use AVX2
+    template <std::uint8_t Shift>
+    __attribute__((target("avx2"))) static void shiftTextAVX2(
+        const std::string_view inputText, char* outputText)
+    {
+        shiftText<Shift>(inputText, outputText);
+    }
+#endif
+};
+
+/**
+ * \class VigenereKernel
+ * \brief Encrypt or decrypt text using the Vigenere cipher with a key fixed at compile time
+ *
+ * The key is given as its letters (C++17 does not allow string literals
+ * as template arguments), which must be uppercase.
+ *
+ * It can be used as follows:
+ * \code{.cpp}
+ * const VigenereKernel<'K', 'E', 'Y'> cipher;
+ * std::string outputText{cipher.applyCipher(inputText, CipherMode::Encrypt)};
+ * \endcode
+ *
+ * \tparam Letters the letters of the cipher key
+ */
+template <char... Letters>
+class VigenereKernel : public Cipher {
+  public:
+    static_assert(sizeof...(Letters) > 0, "the key must not be empty");
+    static_assert((Alphabet::contains(Letters) && ...),
+                  "the key must be made of uppercase letters of the alphabet");
+
+    /// Make the std::string version of applyCipher from the base class visible
+    using Cipher::applyCipher;
+
+    /// The length of the key
+    static constexpr std::size_t keySize{sizeof...(Letters)};
+
+    /// The number of characters ciphered in each pass of the main loop,
+    /// a whole number of copies of the key
+    static constexpr std::size_t blockSize{32 * keySize};
+
+    /// Type definition for the shifts for a block, starting from each key position
+    using ShiftPattern = std::array<std::uint8_t, blockSize + keySize>;
+
+    /**
+     * \brief Build the shifts for each character of a block, repeating the key
+     *
+     * Each block starts at the same key position, so the pattern does not
+     * change from one block to the next.
+     * It is one key longer than a block so that it can be read from any key position.
+     *
+     * \param cipherMode whether the shifts are for encrypting or decrypting
+     * \return the shifts
+     */
+    static constexpr ShiftPattern makeShiftPattern(const CipherMode cipherMode)
+    {
+        constexpr std::array<char, keySize> key{Letters...};
+        ShiftPattern pattern{};
+        for (std::size_t i{0}; i < pattern.size(); ++i) {
+            const std::size_t index{Alphabet::index(key[i % keySize])};
+            pattern[i] = static_cast<std::uint8_t>(
+                (cipherMode == CipherMode::Encrypt)
+                    ? index
+                    : (Alphabet::size - index) % Alphabet::size);
+        }
+        return pattern;
+    }
+
+    /// The shifts for each character of a block when encrypting
+    static constexpr ShiftPattern encryptShifts{
+        makeShiftPattern(CipherMode::Encrypt)};
+
+    /// The shifts for each character of a block when decrypting
+    static constexpr ShiftPattern decryptShifts{
+        makeShiftPattern(CipherMode::Decrypt)};
+
+    /**
+     * \brief Apply the cipher to a chunk of text, writing the result into the provided buffer
+     *
+     * \param chunk the text to encrypt or decrypt, and its offset within the whole text
+     * \param outputText where to write the result, which must have room for
+     *                   outputSize(chunk.text) characters
+     * \param cipherMode whether to encrypt or decrypt the input text
+     * \return the number of characters written to the output
+     */
+    std::size_t applyCipher(const TextChunk& chunk, char* outputText,
+                            const CipherMode cipherMode) const override
+    {
+#ifdef MPAGSCIPHER_FIXEDKEY_AVX2
+        if (ShiftKernels::activeKernel() == ShiftKernels::Kernel::AVX2) {
+            if (cipherMode == CipherMode::Encrypt) {
+                shiftTextAVX2<encryptShifts>(chunk, outputText);
+            } else {
+                shiftTextAVX2<decryptShifts>(chunk, outputText);
+            }
+            return chunk.text.size();
+        }
+#endif
+        if (cipherMode == CipherMode::Encrypt) {
+            shiftText<encryptShifts>(chunk, outputText);
+        } else {
+            shiftText<decryptShifts>(chunk, outputText);
+        }
+        return chunk.text.size();
+    }
+
+    /**
+     * \brief Each chunk carries its offset, so the text can be chunked
+     *
+     * \return true
+     */
+    bool supportsChunking() const override { return true; }
+
+    /**
+     * \brief Each character is replaced by exactly one character, so the cipher can be applied in place
+     *
+     * \return true
+     */
+    bool preservesLength() const override { return true; }
+
+  private:
+    /// Shift the letters of the chunk by the constant Shifts, stepping through the key
+    template <const ShiftPattern& Shifts>
+    static MPAGSCIPHER_FIXEDKEY_INLINE void shiftText(const TextChunk& chunk,
+                                                      char* outputText)
+    {
+        const std::string_view inputText{chunk.text};
+        const std::size_t inputSize{inputText.size()};
+
+        // Start from the key position that matches this chunk's place in
+        // the whole text
+        const std::size_t keyPos{chunk.offset % keySize};
+        const std::uint8_t* shifts{Shifts.data() + keyPos};
+
+        // Take a block at a time, the shifts for which are the same
+        // constants every time, so that the loop over it is vectorised
+        std::size_t i{0};
+        for (; i + blockSize <= inputSize; i += blockSize) {
+            for (std::size_t j{0}; j < blockSize; ++j) {
+                outputText[i + j] = shiftLetter(inputText[i + j], shifts[j]);
+            }
+        }
+
+        // Finish off the partial block at the end
+        for (std::size_t j{0}; i < inputSize; ++i, ++j) {
+            outputText[i] = shiftLetter(inputText[i], shifts[j]);
+        }
+    }
+
+#ifdef MPAGSCIPHER_FIXEDKEY_AVX2
+    /// The same loop, compiled to use AVX2
+    template <const ShiftPattern& Shifts>
+    __attribute__((target("avx2"))) static void shiftTextAVX2(
+        const TextChunk& chunk, char* outputText)
+    {
+        shiftText<Shifts>(chunk, outputText);
+    }
+#endif
+};
+
+#endif    // MPAGSCIPHER_FIXEDKEYCIPHERS_HPP
@@ -0,0 +1,236 @@
+#include "Instrumentation.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace {
+#ifdef MPAGSCIPHER_ENABLE_STATS
+    /// The totals recorded for one stage
+    struct StageTotals {
+        /// The number of times the stage was run
+        std::atomic<std::uint64_t> calls{0};
+        /// The total wall-clock time, in nanoseconds
+        std::atomic<std::uint64_t> wallNs{0};
+        /// The total process CPU time, in nanoseconds
+        std::atomic<std::uint64_t> cpuNs{0};
+        /// The total bytes consumed
+        std::atomic<std::uint64_t> bytesIn{0};
+        /// The total bytes produced
+        std::atomic<std::uint64_t> bytesOut{0};
+    };
+
+    /// Everything that has been recorded
+    struct Statistics {
+        /// Whether recording is switched on
+        std::atomic<bool> enabled{false};
+        /// The totals for each stage
+        std::array<StageTotals, Instrumentation::nStages> stages{};
+        /// The number of times a text was split up
+        std::atomic<std::uint64_t> splits{0};
+        /// The total number of chunks that texts were split into
+        std::atomic<std::uint64_t> chunks{0};
+        /// Protects the busy times, which are only updated once per task
+        std::mutex threadMutex;
+        /// The time each thread spent running tasks, in nanoseconds
+        std::map<std::thread::id, std::uint64_t> threadBusyNs;
+    };
+
+    Statistics& statistics()
+    {
+        static Statistics stats;
+        return stats;
+    }
+
+    std::string stageName(const std::size_t stage)
+    {
+        switch (static_cast<Instrumentation::Stage>(stage)) {
+            case Instrumentation::Stage::Read:
+                return "read";
+            case Instrumentation::Stage::Transform:
+                return "transform";
+            case Instrumentation::Stage::Split:
+                return "split";
+            case Instrumentation::Stage::Cipher:
+                return "cipher";
+            case Instrumentation::Stage::Write:
+                return "write";
+        }
+        return "unknown";
+    }
+
+    double toSeconds(const std::uint64_t ns)
+    {
+        return static_cast<double>(ns) / 1e9;
+    }
+#endif
+}    // namespace
+
+namespace Instrumentation {
+#ifdef MPAGSCIPHER_ENABLE_STATS
+    bool compiledIn()
+    {
+        return true;
+    }
+
+    void enable(const bool on)
+    {
+        statistics().enabled.store(on, std::memory_order_relaxed);
+    }
+
+    bool enabled()
+    {
+        return statistics().enabled.load(std::memory_order_relaxed);
+    }
+
+    void recordStage(const Stage stage, const std::chrono::nanoseconds wallTime,
+                     const std::chrono::nanoseconds cpuTime,
+                     const std::size_t bytesIn, const std::size_t bytesOut)
+    {
+        StageTotals& totals{
+            statistics().stages[static_cast<std::size_t>(stage)]};
+        totals.calls += 1;
+        totals.wallNs += static_cast<std::uint64_t>(wallTime.count());
+        totals.cpuNs += static_cast<std::uint64_t>(cpuTime.count());
+        totals.bytesIn += bytesIn;
+        totals.bytesOut += bytesOut;
+    }
+
+    void recordChunks(const std::size_t nChunks)
+    {
+        if (!enabled()) {
+            return;
+        }
+        statistics().splits += 1;
+        statistics().chunks += nChunks;
+    }
+
+    void recordThreadBusy(const std::chrono::nanoseconds busyTime)
+    {
+        if (!enabled()) {
+            return;
+        }
+        Statistics& stats{statistics()};
+        const std::lock_guard<std::mutex> lock{stats.threadMutex};
+        stats.threadBusyNs[std::this_thread::get_id()] +=
+            static_cast<std::uint64_t>(busyTime.count());
+    }
+
+    void reset()
+    {
+        Statistics& stats{statistics()};
+        for (auto& totals : stats.stages) {
+            totals.calls = 0;
+            totals.wallNs = 0;
+            totals.cpuNs = 0;
+            totals.bytesIn = 0;
+            totals.bytesOut = 0;
+        }
+        stats.splits = 0;
+        stats.chunks = 0;
+        const std::lock_guard<std::mutex> lock{stats.threadMutex};
+        stats.threadBusyNs.clear();
+    }
+
+    void printSummary(std::ostream& out)
+    {
+        Statistics& stats{statistics()};
+        out << "[stats] " << std::left << std::setw(10) << "stage"
+            << std::right << std::setw(8) << "calls" << std::setw(12)
+            << "wall/s" << std::setw(12) << "cpu/s" << std::setw(14)
+            << "bytes in" << std::setw(14) << "bytes out" << "\n";
+        for (std::size_t i{0}; i < nStages; ++i) {
+            const StageTotals& totals{stats.stages[i]};
+            out << "[stats] " << std::left << std::setw(10) << stageName(i)
+                << std::right << std::setw(8) << totals.calls << std::fixed
+                << std::setprecision(6) << std::setw(12)
+                << toSeconds(totals.wallNs) << std::setw(12)
+                << toSeconds(totals.cpuNs) << std::setw(14) << totals.bytesIn
+                << std::setw(14) << totals.bytesOut << std::defaultfloat
+                << "\n";
+        }
+        out << "[stats] chunks: " << stats.chunks << " in " << stats.splits
+            << " splits\n";
+
+        const std::lock_guard<std::mutex> lock{stats.threadMutex};
+        std::size_t threadIndex{0};
+        for (const auto& [id, busyNs] : stats.threadBusyNs) {
+            out << "[stats] thread " << threadIndex++ << " busy: " << std::fixed
+                << std::setprecision(6) << toSeconds(busyNs)
+                << std::defaultfloat << " s\n";
+        }
+        out << std::flush;
+    }
+
+    void writeJson(std::ostream& out)
+    {
+        Statistics& stats{statistics()};
+        out << "{\n  \"stages\": {\n";
+        for (std::size_t i{0}; i < nStages; ++i) {
+            const StageTotals& totals{stats.stages[i]};
+            out << "    \"" << stageName(i) << "\": {\"calls\": " << totals.calls
+                << ", \"wall_seconds\": " << toSeconds(totals.wallNs)
+                << ", \"cpu_seconds\": " << toSeconds(totals.cpuNs)
+                << ", \"bytes_in\": " << totals.bytesIn
+                << ", \"bytes_out\": " << totals.bytesOut << "}"
+                << (i + 1 < nStages ? "," : "") << "\n";
+        }
+        out << "  },\n"
+            << "  \"splits\": " << stats.splits << ",\n"
+            << "  \"chunks\": " << stats.chunks << ",\n"
+            << "  \"thread_busy_seconds\": [";
+
+        const std::lock_guard<std::mutex> lock{stats.threadMutex};
+        bool first{true};
+        for (const auto& [id, busyNs] : stats.threadBusyNs) {
+            out << (first ? "" : ", ") << toSeconds(busyNs);
+            first = false;
+        }
+        out << "]\n}\n";
+    }
+#else
+    bool compiledIn()
+    {
+        return false;
+    }
+
+    void enable(const bool) {}
+
+    bool enabled()
+    {
+        return false;
+    }
+
+    void recordStage(const Stage, const std::chrono::nanoseconds,
+                     const std::chrono::nanoseconds, const std::size_t,
+                     const std::size_t)
+    {
+    }
+
+    void recordChunks(const std::size_t) {}
+
+    void recordThreadBusy(const std::chrono::nanoseconds) {}
+
+    void reset() {}
+
+    void printSummary(std::ostream& out)
+    {
+        out << "[stats] statistics were not compiled into this build"
+            << std::endl;
+    }
+
+    void writeJson(std::ostream& out)
+    {
+        out << "{}\n";
+    }
+#endif
+}    // namespace Instrumentation
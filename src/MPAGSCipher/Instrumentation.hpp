@@ -0,0 +1,194 @@
+#ifndef MPAGSCIPHER_INSTRUMENTATION_HPP
+#define MPAGSCIPHER_INSTRUMENTATION_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+
+/**
+ * \file Instrumentation.hpp
+ * \brief Contains the declarations of the timers and counters used to profile the stages of the program
+ */
+
+/**
+ * \namespace Instrumentation
+ * \brief Namespace to hold the per-stage timers and counters, and the reporting of them
+ *
+ * Recording is off until enable() is called, so that the cost when it is
+ * not wanted is a single check of a flag per stage.
+ * If the library is built without MPAGSCIPHER_ENABLE_STATS everything here
+ * compiles to nothing and compiledIn() returns false.
+ */
+namespace Instrumentation {
+    /**
+     * \enum Stage
+     * \brief The stages that the processing of the text is divided into
+     */
+    enum class Stage {
+        Read,         ///< Reading the input
+        Transform,    ///< Transliterating the input
+        Split,        ///< Splitting the text into chunks for the threads
+        Cipher,       ///< Applying the cipher
+        Write         ///< Writing the output
+    };
+
+    /// The number of stages
+    const std::size_t nStages{5};
+
+    /**
+     * \brief Whether the instrumentation was compiled into the library
+     *
+     * \return true if statistics can be recorded
+     */
+    bool compiledIn();
+
+    /**
+     * \brief Start or stop recording statistics
+     *
+     * \param on whether to record
+     */
+    void enable(const bool on);
+
+    /**
+     * \brief Whether statistics are being recorded
+     *
+     * \return true if recording
+     */
+    bool enabled();
+
+    /**
+     * \brief Record the time taken by, and the bytes going in and out of, one run of a stage
+     *
+     * \param stage the stage that was run
+     * \param wallTime the elapsed wall-clock time
+     * \param cpuTime the CPU time used by the process (by all its threads)
+     * \param bytesIn the number of bytes the stage consumed
+     * \param bytesOut the number of bytes the stage produced
+     */
+    void recordStage(const Stage stage, const std::chrono::nanoseconds wallTime,
+                     const std::chrono::nanoseconds cpuTime,
+                     const std::size_t bytesIn, const std::size_t bytesOut);
+
+    /**
+     * \brief Record the number of chunks that a text was split into
+     *
+     * \param nChunks the number of chunks
+     */
+    void recordChunks(const std::size_t nChunks);
+
+    /**
+     * \brief Record time that the calling thread spent running a task
+     *
+     * \param busyTime the time spent working
+     */
+    void recordThreadBusy(const std::chrono::nanoseconds busyTime);
+
+    /// Forget everything recorded so far
+    void reset();
+
+    /**
+     * \brief Print a human-readable summary of everything recorded
+     *
+     * \param out where to print the summary
+     */
+    void printSummary(std::ostream& out);
+
+    /**
+     * \brief Write everything recorded as a JSON document
+     *
+     * \param out where to write the document
+     */
+    void writeJson(std::ostream& out);
+
+    /**
+     * \class StageTimer
+     * \brief Times one run of a stage, from its construction to its destruction
+     *
+     * It can be used as follows:
+     * \code{.cpp}
+     * {
+     *     Instrumentation::StageTimer timer{Instrumentation::Stage::Cipher, input.size()};
+     *     ...
+     *     timer.setBytesOut(output.size());
+     * }
+     * \endcode
+     */
+    class StageTimer {
+      public:
+#ifdef MPAGSCIPHER_ENABLE_STATS
+        /**
+         * \brief Start timing the stage, if statistics are being recorded
+         *
+         * \param stage the stage being run
+         * \param bytesIn the number of bytes the stage consumes
+         */
+        explicit StageTimer(const Stage stage, const std::size_t bytesIn = 0)
+            : stage_{stage}, bytesIn_{bytesIn}, active_{enabled()}
+        {
+            if (active_) {
+                wallStart_ = std::chrono::steady_clock::now();
+                cpuStart_ = std::clock();
+            }
+        }
+
+        /// Stop timing and record the results
+        ~StageTimer()
+        {
+            if (active_) {
+                const auto wallTime = std::chrono::steady_clock::now() - wallStart_;
+                const std::chrono::duration<double> cpuTime{
+                    static_cast<double>(std::clock() - cpuStart_) /
+                    CLOCKS_PER_SEC};
+                recordStage(
+                    stage_,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(wallTime),
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(cpuTime),
+                    bytesIn_, bytesOut_);
+            }
+        }
+
+        /**
+         * \brief Set the number of bytes in, if it was not known when the timer was started
+         *
+         * \param bytesIn the number of bytes the stage consumed
+         */
+        void setBytesIn(const std::size_t bytesIn) { bytesIn_ = bytesIn; }
+
+        /**
+         * \brief Set the number of bytes out
+         *
+         * \param bytesOut the number of bytes the stage produced
+         */
+        void setBytesOut(const std::size_t bytesOut) { bytesOut_ = bytesOut; }
+
+      private:
+        /// The stage being timed
+        Stage stage_;
+        /// The number of bytes the stage consumed
+        std::size_t bytesIn_;
+        /// The number of bytes the stage produced
+        std::size_t bytesOut_{0};
+        /// Whether statistics were being recorded when the stage started
+        bool active_;
+        /// The wall-clock time when the stage started
+        std::chrono::steady_clock::time_point wallStart_{};
+        /// The process CPU time when the stage started
+        std::clock_t cpuStart_{0};
+#else
+        /// Does nothing, since statistics were compiled out
+        explicit StageTimer(const Stage, const std::size_t = 0) {}
+        /// Does nothing, since statistics were compiled out
+        void setBytesIn(const std::size_t) {}
+        /// Does nothing, since statistics were compiled out
+        void setBytesOut(const std::size_t) {}
+#endif
+      public:
+        /// Timing the same run twice makes no sense, so copying is not allowed
+        StageTimer(const StageTimer& rhs) = delete;
+        /// Timing the same run twice makes no sense, so copying is not allowed
+        StageTimer& operator=(const StageTimer& rhs) = delete;
+    };
+}    // namespace Instrumentation
+
+#endif    // MPAGSCIPHER_INSTRUMENTATION_HPP
@@ -0,0 +1,159 @@
+#include "MappedFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// Memory mapping needs the POSIX system calls
+#if defined(__unix__) || defined(__APPLE__)
+#define MPAGSCIPHER_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    /// Build the message for a failed system call on the given file
+    std::string errorMessage(const std::string& action, const std::string& path)
+    {
+        return "failed to " + action + " file '" + path +
+               "': " + std::strerror(errno);
+    }
+
+#ifdef MPAGSCIPHER_HAVE_MMAP
+    /// Map the open file, closing it if that fails
+    char* mapFile(const int fd, const std::size_t size, const int protection,
+                  const std::string& path)
+    {
+        // An empty file cannot be mapped, but then there is nothing to access
+        if (size == 0) {
+            return nullptr;
+        }
+        void* const data{::mmap(nullptr, size, protection, MAP_SHARED, fd, 0)};
+        if (data == MAP_FAILED) {
+            const std::string message{errorMessage("map", path)};
+            ::close(fd);
+            throw FileError(message);
+        }
+        // This is only advice, so carry on regardless if it is not taken
+        ::madvise(data, size, MADV_SEQUENTIAL);
+        return static_cast<char*>(data);
+    }
+#endif
+}    // namespace
+
+#ifdef MPAGSCIPHER_HAVE_MMAP
+const bool MappedFile::supported{true};
+#else
+const bool MappedFile::supported{false};
+#endif
+
+MappedFile MappedFile::openForReading(const std::string& path)
+{
+#ifdef MPAGSCIPHER_HAVE_MMAP
+    const int fd{::open(path.c_str(), O_RDONLY)};
+    if (fd < 0) {
+        throw FileError(errorMessage("open", path));
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+        const std::string message{errorMessage("check", path)};
+        ::close(fd);
+        throw FileError(message);
+    }
+    const std::size_t size{static_cast<std::size_t>(status.st_size)};
+    return MappedFile{path, fd, mapFile(fd, size, PROT_READ, path), size};
+#else
+    throw FileError("cannot map file '" + path +
+                    "': memory mapping is not supported on this platform");
+#endif
+}
+
+MappedFile MappedFile::createForWriting(const std::string& path,
+                                        const std::size_t size)
+{
+#ifdef MPAGSCIPHER_HAVE_MMAP
+    const int fd{::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0666)};
+    if (fd < 0) {
+        throw FileError(errorMessage("create", path));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        const std::string message{errorMessage("resize", path)};
+        ::close(fd);
+        throw FileError(message);
+    }
+    return MappedFile{path, fd,
+                      mapFile(fd, size, PROT_READ | PROT_WRITE, path), size};
+#else
+    static_cast<void>(size);
+    throw FileError("cannot map file '" + path +
+                    "': memory mapping is not supported on this platform");
+#endif
+}
+
+MappedFile::MappedFile(const std::string& path, const int fd, char* data,
+                       const std::size_t size)
+    : path_{path}, fd_{fd}, data_{data}, size_{size}, mappedSize_{size}
+{
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef MPAGSCIPHER_HAVE_MMAP
+    if (data_) {
+        ::munmap(data_, mappedSize_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+    : path_{std::move(rhs.path_)},
+      fd_{std::exchange(rhs.fd_, -1)},
+      data_{std::exchange(rhs.data_, nullptr)},
+      size_{std::exchange(rhs.size_, 0)},
+      mappedSize_{std::exchange(rhs.mappedSize_, 0)}
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs) noexcept
+{
+    std::swap(path_, rhs.path_);
+    std::swap(fd_, rhs.fd_);
+    std::swap(data_, rhs.data_);
+    std::swap(size_, rhs.size_);
+    std::swap(mappedSize_, rhs.mappedSize_);
+    return *this;
+}
+
+void MappedFile::truncate(const std::size_t size)
+{
+#ifdef MPAGSCIPHER_HAVE_MMAP
+    // The mapping is left at its original size, since the pages beyond the
+    // end of the file are simply never touched again
+    if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        throw FileError(errorMessage("resize", path_));
+    }
+    size_ = size;
+#else
+    static_cast<void>(size);
+#endif
+}
+
+bool MappedFile::refersTo([[maybe_unused]] const std::string& path) const
+{
+#ifdef MPAGSCIPHER_HAVE_MMAP
+    struct stat mine {};
+    struct stat theirs {};
+    if (::fstat(fd_, &mine) != 0 || ::stat(path.c_str(), &theirs) != 0) {
+        return false;
+    }
+    return mine.st_dev == theirs.st_dev && mine.st_ino == theirs.st_ino;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,118 @@
+#ifndef MPAGSCIPHER_MAPPEDFILE_HPP
+#define MPAGSCIPHER_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * \file MappedFile.hpp
+ * \brief Contains the declaration of the MappedFile class
+ */
+
+/**
+ * \class MappedFile
+ * \brief A file mapped into memory, so that it can be read or written without copying
+ *
+ * The pages of the file are accessed directly through data(), and the
+ * kernel is told that they will be used in order so that it can read
+ * ahead and drop pages once they have been used.
+ * Memory mapping is only available on POSIX systems, elsewhere
+ * MappedFile::supported is false and creating one throws FileError.
+ *
+ * It can be used as follows:
+ * \code{.cpp}
+ * const MappedFile input{MappedFile::openForReading("in.txt")};
+ * MappedFile output{MappedFile::createForWriting("out.txt", input.size())};
+ * std::copy(input.data(), input.data() + input.size(), output.data());
+ * \endcode
+ */
+class MappedFile {
+  public:
+    /// Whether files can be memory mapped on this platform
+    static const bool supported;
+
+    /**
+     * \brief Map an existing file for reading
+     *
+     * \param path the file to map
+     * \return the mapped file
+     * \exception FileError if the file cannot be opened or mapped
+     */
+    static MappedFile openForReading(const std::string& path);
+
+    /**
+     * \brief Create (or replace) a file of the given size and map it for writing
+     *
+     * \param path the file to create
+     * \param size the size of the file, which can be reduced later with truncate()
+     * \return the mapped file
+     * \exception FileError if the file cannot be created or mapped
+     */
+    static MappedFile createForWriting(const std::string& path,
+                                       const std::size_t size);
+
+    /// Unmap and close the file
+    ~MappedFile();
+
+    /// Move constructor, leaving the other object empty
+    MappedFile(MappedFile&& rhs) noexcept;
+    /// Move assignment operator, leaving the other object empty
+    MappedFile& operator=(MappedFile&& rhs) noexcept;
+    /// Copying would unmap the file twice, so is not allowed
+    MappedFile(const MappedFile& rhs) = delete;
+    /// Copying would unmap the file twice, so is not allowed
+    MappedFile& operator=(const MappedFile& rhs) = delete;
+
+    /// The contents of the file (null if the file is empty)
+    char* data() { return data_; }
+    /// The contents of the file (null if the file is empty)
+    const char* data() const { return data_; }
+    /// The size of the file
+    std::size_t size() const { return size_; }
+
+    /**
+     * \brief Reduce the size of a file opened for writing
+     *
+     * Anything beyond the new size is discarded and must no longer be accessed
+     *
+     * \param size the new size, which must not be larger than the current one
+     * \exception FileError if the file cannot be resized
+     */
+    void truncate(const std::size_t size);
+
+    /**
+     * \brief Check whether this is the same file as the one at the given path
+     *
+     * \param path the file to compare with
+     * \return true if the path refers to this file
+     */
+    bool refersTo(const std::string& path) const;
+
+  private:
+    /// Take ownership of an open file and its mapping
+    MappedFile(const std::string& path, const int fd, char* data,
+               const std::size_t size);
+
+    /// The path of the file, for error messages
+    std::string path_;
+    /// The file descriptor of the open file
+    int fd_{-1};
+    /// The start of the mapping (null if the file is empty)
+    char* data_{nullptr};
+    /// The size of the file
+    std::size_t size_{0};
+    /// The size of the mapping, which stays the same if the file is truncated
+    std::size_t mappedSize_{0};
+};
+
+/**
+ * \class FileError
+ * \brief Exception thrown when a file cannot be opened, mapped or resized
+ */
+class FileError : public std::runtime_error {
+  public:
+    FileError(const std::string& what) : std::runtime_error(what) {}
+};
+
+#endif    // MPAGSCIPHER_MAPPEDFILE_HPP
@@ -0,0 +1,158 @@
+#include "ParallelCipher.hpp"
+#include "Instrumentation.hpp"
+
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+/// Whether it is worth sharing the work on this text between the pool
+bool worthSplitting(const Cipher& cipher, const TextChunk& input,
+                    const ThreadPool& pool)
+{
+    return pool.size() >= 2 && input.text.size() >= pool.size() &&
+           cipher.supportsChunking();
+}
+
+/// The chunks that the text is split into, and where their results will go
+struct ChunkPlan {
+    /// The chunks of the text, with their offsets in the whole text
+    std::vector<TextChunk> chunks;
+    /// Where the result for each chunk starts in the output
+    std::vector<std::size_t> outputOffsets;
+    /// The total size of the output
+    std::size_t outputSize;
+};
+
+ChunkPlan planChunks(const Cipher& cipher, const TextChunk& input,
+                     ThreadPool& pool)
+{
+    Instrumentation::StageTimer timer{Instrumentation::Stage::Split,
+                                      input.text.size()};
+
+    // Split the text once into views, placing the chunks at the right
+    // offsets within the whole text that the input is itself a part of
+    ChunkPlan plan{cipher.splitString(input.text, pool.size()), {}, 0};
+    for (auto& chunk : plan.chunks) {
+        chunk.offset += input.offset;
+    }
+
+    // Work out where each chunk's result will go, so that the workers can
+    // write straight into the output (finding the size of each chunk's
+    // result may need a pass over the chunk, so do that in parallel too)
+    std::vector<std::future<std::size_t>> sizeFutures;
+    sizeFutures.reserve(plan.chunks.size());
+    for (const auto& chunk : plan.chunks) {
+        sizeFutures.push_back(pool.submit(
+            [&cipher, chunk] { return cipher.outputSize(chunk.text); }));
+    }
+    plan.outputOffsets.reserve(plan.chunks.size());
+    for (auto& sizeFuture : sizeFutures) {
+        plan.outputOffsets.push_back(plan.outputSize);
+        plan.outputSize += sizeFuture.get();
+    }
+    Instrumentation::recordChunks(plan.chunks.size());
+    return plan;
+}
+
+void runChunks(const Cipher& cipher, const ChunkPlan& plan, char* outputText,
+               const CipherMode cipherMode, ThreadPool& pool)
+{
+    Instrumentation::StageTimer timer{Instrumentation::Stage::Cipher};
+    timer.setBytesOut(plan.outputSize);
+
+    // Hand each chunk to the pool
+    std::vector<std::future<std::size_t>> futures;
+    futures.reserve(plan.chunks.size());
+    for (std::size_t i{0}; i < plan.chunks.size(); ++i) {
+        char* const chunkOutput{outputText + plan.outputOffsets[i]};
+        const TextChunk chunk{plan.chunks[i]};
+        futures.push_back(pool.submit([&cipher, chunk, chunkOutput, cipherMode] {
+            return cipher.applyCipher(chunk, chunkOutput, cipherMode);
+        }));
+    }
+
+    // Wait for all the chunks to be done (rethrowing any exception)
+    std::size_t bytesIn{0};
+    for (std::size_t i{0}; i < futures.size(); ++i) {
+        futures[i].get();
+        bytesIn += plan.chunks[i].text.size();
+    }
+    timer.setBytesIn(bytesIn);
+}
+
+/// Apply the cipher to the whole input on the calling thread
+std::size_t applySerially(const Cipher& cipher, const TextChunk& input,
+                          char* outputText, const CipherMode cipherMode)
+{
+    Instrumentation::StageTimer timer{Instrumentation::Stage::Cipher,
+                                      input.text.size()};
+    Instrumentation::recordChunks(1);
+    const std::size_t nWritten{
+        cipher.applyCipher(input, outputText, cipherMode)};
+    timer.setBytesOut(nWritten);
+    return nWritten;
+}
+
+}    // namespace
+
+std::string applyCipherParallel(const Cipher& cipher,
+                                const std::string& inputText,
+                                const CipherMode cipherMode, ThreadPool& pool)
+{
+    return applyCipherParallel(cipher, TextChunk{inputText, 0}, cipherMode,
+                               pool);
+}
+
+std::string applyCipherParallel(const Cipher& cipher, const TextChunk& input,
+                                const CipherMode cipherMode, ThreadPool& pool)
+{
+    // If there is nothing to gain from splitting, just run the cipher here
+    if (!worthSplitting(cipher, input, pool)) {
+        std::string outputText(cipher.outputSize(input.text), '\0');
+        outputText.resize(
+            applySerially(cipher, input, outputText.data(), cipherMode));
+        return outputText;
+    }
+
+    const ChunkPlan plan{planChunks(cipher, input, pool)};
+    std::string outputText(plan.outputSize, '\0');
+    runChunks(cipher, plan, outputText.data(), cipherMode, pool);
+    return outputText;
+}
+
+std::size_t applyCipherParallel(const Cipher& cipher, const TextChunk& input,
+                                char* outputText, const CipherMode cipherMode,
+                                ThreadPool& pool)
+{
+    if (!worthSplitting(cipher, input, pool)) {
+        return applySerially(cipher, input, outputText, cipherMode);
+    }
+
+    const ChunkPlan plan{planChunks(cipher, input, pool)};
+    runChunks(cipher, plan, outputText, cipherMode, pool);
+    return plan.outputSize;
+}
+
+void applyCipherParallelInPlace(const Cipher& cipher, char* text,
+                                const std::size_t size,
+                                const CipherMode cipherMode, ThreadPool& pool)
+{
+    const TextChunk input{std::string_view{text, size}, 0};
+    if (!cipher.preservesLength()) {
+        throw InPlaceNotSupported(
+            "cipher changes the length of the text so cannot be applied in place");
+    }
+
+    if (!worthSplitting(cipher, input, pool)) {
+        applySerially(cipher, input, text, cipherMode);
+        return;
+    }
+
+    // The result for each chunk is the same length as the chunk, so each
+    // one is written over itself
+    const ChunkPlan plan{planChunks(cipher, input, pool)};
+    runChunks(cipher, plan, text, cipherMode, pool);
+}
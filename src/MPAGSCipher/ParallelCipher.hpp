@@ -0,0 +1,77 @@
+#ifndef MPAGSCIPHER_PARALLELCIPHER_HPP
+#define MPAGSCIPHER_PARALLELCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "TextChunk.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <string>
+
+/**
+ * \file ParallelCipher.hpp
+ * \brief Contains the declaration of the function for applying a cipher using multiple threads
+ */
+
+/**
+ * \brief Apply the cipher to the provided text, sharing the work between the threads of the pool
+ *
+ * The text is split once into one chunk per worker and each worker writes
+ * the result for its chunk directly into its place in the output, so the
+ * text is never copied.
+ * Ciphers that do not support being applied to independent chunks are
+ * simply applied to the whole text.
+ *
+ * \param cipher the cipher to apply
+ * \param inputText the text to encrypt or decrypt
+ * \param cipherMode whether to encrypt or decrypt the input text
+ * \param pool the workers to use
+ * \return the result of applying the cipher to the input text
+ */
+std::string applyCipherParallel(const Cipher& cipher,
+                                const std::string& inputText,
+                                const CipherMode cipherMode, ThreadPool& pool);
+
+/**
+ * \brief Apply the cipher to a chunk of a larger text, sharing the work between the threads of the pool
+ *
+ * \param cipher the cipher to apply
+ * \param input the text to encrypt or decrypt, and its offset within the whole text
+ * \param cipherMode whether to encrypt or decrypt the input text
+ * \param pool the workers to use
+ * \return the result of applying the cipher to the input text
+ */
+std::string applyCipherParallel(const Cipher& cipher, const TextChunk& input,
+                                const CipherMode cipherMode, ThreadPool& pool);
+
+/**
+ * \brief Apply the cipher to a chunk of a larger text, sharing the work between the threads of the pool and writing the result into the provided buffer
+ *
+ * \param cipher the cipher to apply
+ * \param input the text to encrypt or decrypt, and its offset within the whole text
+ * \param outputText where to write the result, which must have room for
+ *                   cipher.outputSize(input.text) characters
+ * \param cipherMode whether to encrypt or decrypt the input text
+ * \param pool the workers to use
+ * \return the number of characters written to the output
+ */
+std::size_t applyCipherParallel(const Cipher& cipher, const TextChunk& input,
+                                char* outputText, const CipherMode cipherMode,
+                                ThreadPool& pool);
+
+/**
+ * \brief Apply the cipher to text held in a buffer, overwriting it with the result and sharing the work between the threads of the pool
+ *
+ * \param cipher the cipher to apply
+ * \param text the text to encrypt or decrypt, which is replaced by the result
+ * \param size the number of characters in the text
+ * \param cipherMode whether to encrypt or decrypt the input text
+ * \param pool the workers to use
+ * \exception InPlaceNotSupported if the cipher does not preserve the length of the text
+ */
+void applyCipherParallelInPlace(const Cipher& cipher, char* text,
+                                const std::size_t size,
+                                const CipherMode cipherMode, ThreadPool& pool);
+
+#endif    // MPAGSCIPHER_PARALLELCIPHER_HPP
@@ -2,14 +2,28 @@
 #include "Alphabet.hpp"
 
 #include <algorithm>
+#include <array>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
-PlayfairCipher::PlayfairCipher(const std::string& key)
+namespace {
+    /// The Playfair grid has no J, so it is replaced with I
+    inline char replaceJ(const char c)
+    {
+        return (c == 'J') ? 'I' : c;
+    }
+}    // namespace
+
+PlayfairCipher::PlayfairCipher(const std::string& key,
+                               const bool precomputeDigraphs)
 {
-    this->setKey(key);
+    this->setKey(key, precomputeDigraphs);
 }
 
-void PlayfairCipher::setKey(const std::string& key)
+void PlayfairCipher::setKey(const std::string& key,
+                            const bool precomputeDigraphs)
 {
     // Store the original key
     key_ = key;
@@ -30,11 +44,13 @@ void PlayfairCipher::setKey(const std::string& key)
     std::transform(std::begin(key_), std::end(key_), std::begin(key_),
                    [](char c) { return (c == 'J') ? 'I' : c; });
 
-    // Remove duplicated letters
-    std::string lettersFound{""};
+    // Remove duplicated letters, keeping track of those already found by
+    // their position in the alphabet rather than searching for them
+    std::array<bool, Alphabet::size> lettersFound{};
     auto detectDuplicates = [&](char c) {
-        if (lettersFound.find(c) == std::string::npos) {
-            lettersFound += c;
+        const std::size_t index{Alphabet::index(c)};
+        if (!lettersFound[index]) {
+            lettersFound[index] = true;
             return false;
         } else {
             return true;
@@ -44,98 +60,204 @@ void PlayfairCipher::setKey(const std::string& key)
         std::remove_if(std::begin(key_), std::end(key_), detectDuplicates),
         std::end(key_));
 
-    // Store the coordinates of each letter
+    // Store the grid, and the position in it of each letter
     // (at this point the key length must be equal to the square of the grid dimension)
     for (std::size_t i{0}; i < keyLength_; ++i) {
-        std::size_t row{i / gridSize_};
-        std::size_t column{i % gridSize_};
+        grid_[i] = key_[i];
+        letterPositions_[Alphabet::index(key_[i])] =
+            static_cast<unsigned char>(i);
+    }
+    letterPositions_[Alphabet::index('J')] =
+        letterPositions_[Alphabet::index('I')];
+
+    // Optionally work out the substitution for every possible digraph up front
+    useDigraphTables_ = precomputeDigraphs;
+    if (useDigraphTables_) {
+        for (std::size_t posOne{0}; posOne < keyLength_; ++posOne) {
+            for (std::size_t posTwo{0}; posTwo < keyLength_; ++posTwo) {
+                const std::size_t index{posOne * keyLength_ + posTwo};
+                encryptDigraphs_[index] =
+                    this->transformDigraph(posOne, posTwo, CipherMode::Encrypt);
+                decryptDigraphs_[index] =
+                    this->transformDigraph(posOne, posTwo, CipherMode::Decrypt);
+            }
+        }
+    }
+}
+
+PlayfairCipher::Digraph PlayfairCipher::transformDigraph(
+    const std::size_t posOne, const std::size_t posTwo,
+    const CipherMode cipherMode) const
+{
+    // Depending on encryption/decryption mode, set whether to increment or
+    // decrement the column/row index (modulo the grid dimension)
+    const std::size_t shift{
+        (cipherMode == CipherMode::Encrypt) ? 1u : gridSize_ - 1u};
+
+    // Find the coordinates in the grid for each letter
+    std::size_t rowOne{posOne / gridSize_};
+    std::size_t columnOne{posOne % gridSize_};
+    std::size_t rowTwo{posTwo / gridSize_};
+    std::size_t columnTwo{posTwo % gridSize_};
+
+    // Find whether the two points are on a row, a column or form a rectangle/square
+    // Then apply the appropriate rule to these coords to get new coords
+    if (rowOne == rowTwo) {
+        // Row - so increment/decrement the column indices (modulo the grid dimension)
+        columnOne = (columnOne + shift) % gridSize_;
+        columnTwo = (columnTwo + shift) % gridSize_;
 
-        auto coords = std::make_pair(row, column);
+    } else if (columnOne == columnTwo) {
+        // Column - so increment/decrement the row indices (modulo the grid dimension)
+        rowOne = (rowOne + shift) % gridSize_;
+        rowTwo = (rowTwo + shift) % gridSize_;
 
-        charLookup_[key_[i]] = coords;
-        coordLookup_[coords] = key_[i];
+    } else {
+        // Rectangle/Square - so keep the rows the same and swap the columns
+        // (NB the operation is actually the same regardless of encrypt/decrypt
+        // since applying the same operation twice gets you back to where you were)
+        std::swap(columnOne, columnTwo);
     }
+
+    // Find the letters at the new coords
+    return {grid_[rowOne * gridSize_ + columnOne],
+            grid_[rowTwo * gridSize_ + columnTwo]};
 }
 
-std::string PlayfairCipher::applyCipher(const std::string& inputText,
-                                        const CipherMode cipherMode) const
+std::size_t PlayfairCipher::position(const char letter) const
 {
-    // Create the output string, initially a copy of the input text
-    std::string outputText{inputText};
+    const std::size_t index{Alphabet::index(letter)};
+    if (index >= letterPositions_.size()) {
+        throw std::out_of_range(std::string{"Playfair cipher cannot process '"} +
+                                letter + "'");
+    }
+    return letterPositions_[index];
+}
 
-    // Change J -> I
-    std::transform(std::begin(outputText), std::end(outputText),
-                   std::begin(outputText),
-                   [](char c) { return (c == 'J') ? 'I' : c; });
+std::size_t PlayfairCipher::outputSize(const std::string_view inputText) const
+{
+    // Count the digraphs that will be formed, following the same rules as applyCipher
+    const std::size_t inputSize{inputText.size()};
+    std::size_t nDigraphs{0};
+    std::size_t i{0};
+    while (i < inputSize) {
+        // A digraph uses up two input characters unless they are the same
+        // (after changing J -> I) or we have reached the last character
+        if (i + 1 < inputSize &&
+            replaceJ(inputText[i]) != replaceJ(inputText[i + 1])) {
+            i += 2;
+        } else {
+            i += 1;
+        }
+        ++nDigraphs;
+    }
+    return 2 * nDigraphs;
+}
 
-    // Find repeated characters (but only when they occur within a bigram)
-    // and add an X (or a Q for repeated X's) between them
-    std::string tmpText{""};
-    // Reserve space to hold the size of the input text plus a bit of headroom
-    tmpText.reserve(outputText.size() * 1.1);
-    for (std::size_t i{0}; i < outputText.size(); i += 2) {
-        // Always add the first of the bigram
-        tmpText += outputText[i];
-        if (i + 1 == outputText.size()) {
-            // If this was the last character then we've ended up with an odd-length input
-            // so add Z to the end (or X if the last character is a Z)
-            tmpText += (outputText[i] == 'Z') ? 'X' : 'Z';
-            // then explicitly break out of the loop since we've finished
-            break;
-        } else if (outputText[i] != outputText[i + 1]) {
-            // If the two characters in the bigram are different,
-            // simply add the second one as well
-            tmpText += outputText[i + 1];
+std::size_t PlayfairCipher::completeLength(
+    const std::string_view inputText) const
+{
+    // Step through the digraphs, following the same rules as applyCipher,
+    // remembering where the last one made of two different letters ended
+    const std::size_t inputSize{inputText.size()};
+    std::size_t complete{0};
+    std::size_t i{0};
+    while (i + 1 < inputSize) {
+        if (replaceJ(inputText[i]) != replaceJ(inputText[i + 1])) {
+            i += 2;
+            complete = i;
         } else {
-            // Otherwise, if two characters in the bigram are the same,
-            // we instead add an X (or a Q if the first was an X)
-            tmpText += (outputText[i] == 'X') ? 'Q' : 'X';
-            // Need to decrement i since the second character in this bigram now
-            // becomes the first character in the next one
-            --i;
+            i += 1;
         }
     }
+    return complete;
+}
 
-    // Swap the contents of the original and modified strings - cheaper than assignment
-    outputText.swap(tmpText);
+std::vector<TextChunk> PlayfairCipher::splitString(const std::string_view str,
+                                                  const std::size_t n) const
+{
+    // Aim for chunks of equal length (rounded up so we need at most n of them)
+    const std::size_t size{str.size()};
+    const std::size_t partSize{(n == 0) ? size : (size + n - 1) / n};
+    std::vector<TextChunk> chunks{};
 
-    // Depending on encryption/decryption mode, set whether to increment or
-    // decrement the column/row index (modulo the grid dimension)
-    const std::size_t shift{
-        (cipherMode == CipherMode::Encrypt) ? 1u : gridSize_ - 1u};
+    // Step through the text one digraph at a time, following the same rules
+    // as applyCipher, and end each chunk at the first digraph start that is
+    // at or beyond its target length.
+    // The chunk must not end just after a digraph that was padded because of
+    // a repeated letter, since on its own in the chunk that letter would
+    // instead be treated as the odd one out at the end of the text.
+    std::size_t chunkStart{0};
+    std::size_t i{0};
+    while (chunkStart < size) {
+        const std::size_t target{std::min(chunkStart + partSize, size)};
+        bool padded{false};
+        while (i < size && (i < target || padded)) {
+            padded = !(i + 1 < size && replaceJ(str[i]) != replaceJ(str[i + 1]));
+            i += padded ? 1 : 2;
+        }
+        chunks.push_back(
+            TextChunk{str.substr(chunkStart, i - chunkStart), chunkStart});
+        chunkStart = i;
+    }
+
+    return chunks;
+}
+
+std::size_t PlayfairCipher::applyCipher(const TextChunk& chunk,
+                                        char* outputText,
+                                        const CipherMode cipherMode) const
+{
+    const std::string_view inputText{chunk.text};
 
-    // Loop over the input digraphs
-    for (std::size_t i{0}; i < outputText.size(); i += 2) {
-        // Find the coordinates in the grid for each digraph
-        PlayfairCoords pointOne{charLookup_.at(outputText[i])};
-        PlayfairCoords pointTwo{charLookup_.at(outputText[i + 1])};
-        auto& [rowOne, columnOne]{pointOne};
-        auto& [rowTwo, columnTwo]{pointTwo};
-
-        // Find whether the two points are on a row, a column or form a rectangle/square
-        // Then apply the appropriate rule to these coords to get new coords
-        if (rowOne == rowTwo) {
-            // Row - so increment/decrement the column indices (modulo the grid dimension)
-            columnOne = (columnOne + shift) % gridSize_;
-            columnTwo = (columnTwo + shift) % gridSize_;
-
-        } else if (columnOne == columnTwo) {
-            // Column - so increment/decrement the row indices (modulo the grid dimension)
-            rowOne = (rowOne + shift) % gridSize_;
-            rowTwo = (rowTwo + shift) % gridSize_;
+    // Select the digraph table for the requested mode
+    const DigraphTable& table{(cipherMode == CipherMode::Encrypt)
+                                  ? encryptDigraphs_
+                                  : decryptDigraphs_};
 
+    // Make a single pass over the input, forming each digraph as we go
+    // and writing its substitution straight into the output
+    const std::size_t inputSize{inputText.size()};
+    std::size_t nWritten{0};
+    std::size_t i{0};
+    while (i < inputSize) {
+        // Always take the first character of the digraph (changing J -> I)
+        const char first{replaceJ(inputText[i])};
+        char second{'Z'};
+        if (i + 1 == inputSize) {
+            // If this was the last character then we've ended up with an odd-length input
+            // so add Z to the end (or X if the last character is a Z)
+            second = (first == 'Z') ? 'X' : 'Z';
+            i += 1;
         } else {
-            // Rectangle/Square - so keep the rows the same and swap the columns
-            // (NB the operation is actually the same regardless of encrypt/decrypt
-            // since applying the same operation twice gets you back to where you were)
-            std::swap(columnOne, columnTwo);
+            const char next{replaceJ(inputText[i + 1])};
+            if (first != next) {
+                // If the two characters in the digraph are different,
+                // simply use the second one as well
+                second = next;
+                i += 2;
+            } else {
+                // Otherwise, if two characters in the digraph are the same,
+                // we instead use an X (or a Q if the first was an X)
+                // and the repeated character starts the next digraph
+                second = (first == 'X') ? 'Q' : 'X';
+                i += 1;
+            }
         }
 
-        // Find the letters associated with the new coords and make the replacements
-        outputText[i] = coordLookup_.at(pointOne);
-        outputText[i + 1] = coordLookup_.at(pointTwo);
+        // Find the position in the grid of each letter of the digraph
+        const std::size_t posOne{this->position(first)};
+        const std::size_t posTwo{this->position(second)};
+
+        // Look up or calculate the replacement digraph
+        const Digraph newDigraph{
+            useDigraphTables_
+                ? table[posOne * keyLength_ + posTwo]
+                : this->transformDigraph(posOne, posTwo, cipherMode)};
+
+        outputText[nWritten++] = newDigraph[0];
+        outputText[nWritten++] = newDigraph[1];
     }
 
-    // Return the output text
-    return outputText;
-}
\ No newline at end of file
+    return nWritten;
+}
@@ -3,9 +3,12 @@
 
 #include "Cipher.hpp"
 #include "CipherMode.hpp"
+#include "TextChunk.hpp"
 
-#include <map>
+#include <array>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**
  * \file PlayfairCipher.hpp
@@ -22,26 +25,97 @@ class PlayfairCipher : public Cipher {
      * \brief Create a new PlayfairCipher with the given key
      *
      * \param key the key to use in the cipher
+     * \param precomputeDigraphs whether to build the full digraph substitution tables
      */
-    explicit PlayfairCipher(const std::string& key);
+    explicit PlayfairCipher(const std::string& key,
+                            const bool precomputeDigraphs = true);
 
     /**
      * \brief Set the key to be used for the encryption/decryption
      *
+     * When precomputeDigraphs is true, the result of encrypting and decrypting
+     * every possible digraph is stored, so that applying the cipher needs
+     * only one table lookup per digraph.
+     * Otherwise each digraph is transformed using the row/column rules.
+     *
      * \param key the key to use in the cipher
+     * \param precomputeDigraphs whether to build the full digraph substitution tables
      */
-    void setKey(const std::string& key);
+    void setKey(const std::string& key, const bool precomputeDigraphs = true);
+
+    /// Make the std::string version of applyCipher from the base class visible
+    using Cipher::applyCipher;
 
     /**
-     * \brief Apply the cipher to the provided text
+     * \brief Apply the cipher to a chunk of text, writing the result into the provided buffer
      *
-     * \param inputText the text to encrypt or decrypt
+     * \param chunk the text to encrypt or decrypt, and its offset within the whole text
+     * \param outputText where to write the result, which must have room for
+     *                   outputSize(chunk.text) characters
      * \param cipherMode whether to encrypt or decrypt the input text
-     * \return the result of applying the cipher to the input text
+     * \return the number of characters written to the output
      */
-    std::string applyCipher(const std::string& inputText,
+    std::size_t applyCipher(const TextChunk& chunk, char* outputText,
                             const CipherMode cipherMode) const override;
 
+    /**
+     * \brief The number of characters produced by applying the cipher to the provided text
+     *
+     * This accounts for the padding characters inserted between repeated
+     * letters and at the end of an odd-length text
+     *
+     * \param inputText the text to be encrypted or decrypted
+     * \return the size of the result of applying the cipher
+     */
+    std::size_t outputSize(const std::string_view inputText) const override;
+
+    /**
+     * \brief At most every character becomes a digraph of its own
+     *
+     * \param inputSize the length of the text to be encrypted or decrypted
+     * \return twice the length of the text
+     */
+    std::size_t maxOutputSize(const std::size_t inputSize) const override
+    {
+        return 2 * inputSize;
+    }
+
+    /**
+     * \brief The length of the start of the text made up of digraphs that are already complete
+     *
+     * A letter at the end of the text read so far might still be paired
+     * with the next letter to arrive, and a padded digraph might be the
+     * last of the text, so the text is only ever cut after a digraph of two
+     * different letters.
+     *
+     * \param inputText the text read so far that has not yet been ciphered
+     * \return the number of characters at the start of the text that can be ciphered now
+     */
+    std::size_t completeLength(const std::string_view inputText) const override;
+
+    /**
+     * \brief Chunks are split at digraph boundaries, so the text can be chunked
+     *
+     * \return true
+     */
+    bool supportsChunking() const override { return true; }
+
+    /**
+     * \brief Split the text into chunks that each start at the beginning of a digraph
+     *
+     * Where the digraphs fall depends on every repeated letter before them,
+     * so this makes a quick pass over the text to find, for each roughly
+     * equal split point, the start of the next digraph.
+     * Each chunk can then be ciphered independently and the results joined
+     * to give the same result as ciphering the whole text.
+     *
+     * \param str the text to be split up
+     * \param n number of threads
+     * \return the consecutive, non-overlapping chunks, at most n of them
+     */
+    std::vector<TextChunk> splitString(const std::string_view str,
+                                       const std::size_t n) const override;
+
   private:
     /// The grid size
     const std::string::size_type gridSize_{5};
@@ -54,14 +128,48 @@ class PlayfairCipher : public Cipher {
 
     // Lookup tables generated from the key
 
-    /// Type definition for the coordinates in the 5x5 table
-    using PlayfairCoords = std::pair<std::size_t, std::size_t>;
+    /// The 5x5 grid, stored row by row
+    std::array<char, 25> grid_{};
+
+    /// Lookup table to go from a letter ('A' to 'Z') to its position in the grid
+    /// (J shares the position of I)
+    std::array<unsigned char, 26> letterPositions_{};
+
+    /// Type definition for a pair of letters
+    using Digraph = std::array<char, 2>;
+
+    /// Type definition for a table holding the substitution for every digraph,
+    /// indexed by the grid positions of the two letters
+    using DigraphTable = std::array<Digraph, 25 * 25>;
 
-    /// Lookup table to go from the character to the coordinates
-    std::map<char, PlayfairCoords> charLookup_;
+    /// Whether the digraph tables have been built
+    bool useDigraphTables_{true};
 
-    /// Lookup table to go from the coordinates to the character
-    std::map<PlayfairCoords, char> coordLookup_;
+    /// The result of encrypting each digraph
+    DigraphTable encryptDigraphs_{};
+
+    /// The result of decrypting each digraph
+    DigraphTable decryptDigraphs_{};
+
+    /**
+     * \brief Apply the Playfair rules to a single digraph
+     *
+     * \param posOne the grid position of the first letter
+     * \param posTwo the grid position of the second letter
+     * \param cipherMode whether to encrypt or decrypt the digraph
+     * \return the transformed digraph
+     */
+    Digraph transformDigraph(const std::size_t posOne, const std::size_t posTwo,
+                             const CipherMode cipherMode) const;
+
+    /**
+     * \brief Find the position in the grid of the given letter
+     *
+     * \param letter the letter to look up
+     * \return the position of the letter in the grid
+     * \exception std::out_of_range if the character is not an uppercase letter
+     */
+    std::size_t position(const char letter) const;
 };
 
 #endif
\ No newline at end of file
@@ -58,6 +58,75 @@ void processCommandLine(const std::vector<std::string>& cmdLineArgs,
                 settings.cipherKey = cmdLineArgs[i + 1];
                 ++i;
             }
+        } else if (cmdLineArgs[i] == "--threads") {
+            // Handle number of threads option
+            // Next element is the number unless --threads is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument("--threads requires a positive integer argument");
+            } else {
+                // Got the number, so check it is a positive integer
+                // (leaving it as zero if not) then advance past it
+                const std::string& nThreads{cmdLineArgs[i + 1]};
+                std::size_t value{0};
+                if (!nThreads.empty() &&
+                    nThreads.find_first_not_of("0123456789") ==
+                        std::string::npos) {
+                    try {
+                        value = std::stoul(nThreads);
+                    } catch (const std::out_of_range&) {
+                        value = 0;
+                    }
+                }
+                if (value == 0) {
+                    throw InvalidArgument(
+                        "--threads requires a positive integer argument, got: " +
+                        nThreads);
+                }
+                settings.nThreads = value;
+                ++i;
+            }
+        } else if (cmdLineArgs[i] == "--stream") {
+            settings.streamMode = true;
+        } else if (cmdLineArgs[i] == "--stats") {
+            settings.statsRequested = true;
+        } else if (cmdLineArgs[i] == "--stats-file") {
+            // Handle statistics file option
+            // Next element is filename unless "--stats-file" is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument("--stats-file requires a filename argument");
+            } else {
+                // Got filename, so assign value and advance past it
+                settings.statsFile = cmdLineArgs[i + 1];
+                ++i;
+            }
+        } else if (cmdLineArgs[i] == "--crack") {
+            settings.crackRequested = true;
+        } else if (cmdLineArgs[i] == "--crack-sample") {
+            // Handle crack sample size option
+            // Next element is the number unless --crack-sample is the last argument
+            if (i == nCmdLineArgs - 1) {
+                throw MissingArgument("--crack-sample requires a positive integer argument");
+            } else {
+                // Got the number, so check it is a positive integer then advance past it
+                const std::string& sampleKB{cmdLineArgs[i + 1]};
+                std::size_t value{0};
+                if (!sampleKB.empty() &&
+                    sampleKB.find_first_not_of("0123456789") ==
+                        std::string::npos) {
+                    try {
+                        value = std::stoul(sampleKB);
+                    } catch (const std::out_of_range&) {
+                        value = 0;
+                    }
+                }
+                if (value == 0) {
+                    throw InvalidArgument(
+                        "--crack-sample requires a positive integer argument, got: " +
+                        sampleKB);
+                }
+                settings.crackSampleKB = value;
+                ++i;
+            }
         } else if (cmdLineArgs[i] == "--encrypt") {
             settings.cipherMode = CipherMode::Encrypt;
         } else if (cmdLineArgs[i] == "--decrypt") {
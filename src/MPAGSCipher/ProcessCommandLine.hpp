@@ -32,6 +32,18 @@ struct ProgramSettings {
     CipherMode cipherMode;
     /// Flag indicating which cipher to use (e.g. Caesar, Playfair, etc.)
     CipherType cipherType;
+    /// Number of threads to use when applying the cipher (0 means one per hardware thread)
+    std::size_t nThreads{0};
+    /// Indicates that the input should be read and ciphered a block at a time rather than all at once
+    bool streamMode{false};
+    /// Indicates that timings and counts for each stage of the processing should be printed at exit
+    bool statsRequested{false};
+    /// Name of the file to write the statistics to as JSON (none if empty)
+    std::string statsFile{};
+    /// Indicates that the Caesar key should be found by frequency analysis and the input decrypted with it
+    bool crackRequested{false};
+    /// Number of kilobytes at the start of the input to use when finding the key (0 means all of it)
+    std::size_t crackSampleKB{0};
 };
 
 /**
@@ -60,6 +72,13 @@ class UnknownArgument : public std::invalid_argument {
     std::invalid_argument(what) {}
 };
 
+class InvalidArgument : public std::invalid_argument {
+  public:
+
+    InvalidArgument(const std::string& what) :
+    std::invalid_argument(what) {}
+};
+
 
 
 #endif    // MPAGSCIPHER_PROCESSCOMMANDLINE_HPP
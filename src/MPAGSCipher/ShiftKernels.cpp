@@ -0,0 +1,359 @@
+#include "ShiftKernels.hpp"
+#include "Alphabet.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// The vectorised kernels are only available when building for x86 with a
+// compiler that lets us enable instruction sets per-function, so that the
+// rest of the library does not need to be built with e.g. -mavx2
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MPAGSCIPHER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+#ifdef MPAGSCIPHER_X86_KERNELS
+    /// Shift the letters in 16 characters by the corresponding shifts
+    __attribute__((target("sse2"))) inline __m128i shiftLettersSSE2(
+        const __m128i chars, const __m128i shifts)
+    {
+        // Find which bytes are letters, i.e. 'A' <= c <= 'Z'
+        // (bytes >= 0x80 are negative as signed chars, so are excluded)
+        const __m128i isLetter{_mm_and_si128(
+            _mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+            _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)))};
+
+        // Add the shift and wrap anything that went past 'Z'
+        // (the largest possible value, 'Z' + 25, still fits in a signed char)
+        __m128i shifted{_mm_add_epi8(chars, shifts)};
+        const __m128i wrap{_mm_cmpgt_epi8(shifted, _mm_set1_epi8('Z'))};
+        shifted = _mm_sub_epi8(
+            shifted, _mm_and_si128(wrap, _mm_set1_epi8(static_cast<char>(Alphabet::size))));
+
+        // Keep the original value for anything that wasn't a letter
+        return _mm_or_si128(_mm_and_si128(isLetter, shifted),
+                            _mm_andnot_si128(isLetter, chars));
+    }
+
+    /// Shift the letters in 32 characters by the corresponding shifts
+    __attribute__((target("avx2"))) inline __m256i shiftLettersAVX2(
+        const __m256i chars, const __m256i shifts)
+    {
+        // Same steps as the SSE2 version, but twice as wide
+        const __m256i isLetter{_mm256_and_si256(
+            _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('A' - 1)),
+            _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), chars))};
+
+        __m256i shifted{_mm256_add_epi8(chars, shifts)};
+        const __m256i wrap{_mm256_cmpgt_epi8(shifted, _mm256_set1_epi8('Z'))};
+        shifted = _mm256_sub_epi8(
+            shifted, _mm256_and_si256(wrap, _mm256_set1_epi8(static_cast<char>(Alphabet::size))));
+
+        return _mm256_blendv_epi8(chars, shifted, isLetter);
+    }
+
+    __attribute__((target("sse2"))) std::size_t caesarShiftSSE2(
+        const char* input, char* output, const std::size_t size,
+        const std::size_t shift)
+    {
+        const __m128i shifts{_mm_set1_epi8(static_cast<char>(shift))};
+        std::size_t i{0};
+        for (; i + 16 <= size; i += 16) {
+            const __m128i chars{_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(input + i))};
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                             shiftLettersSSE2(chars, shifts));
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) std::size_t caesarShiftAVX2(
+        const char* input, char* output, const std::size_t size,
+        const std::size_t shift)
+    {
+        const __m256i shifts{_mm256_set1_epi8(static_cast<char>(shift))};
+        std::size_t i{0};
+        for (; i + 32 <= size; i += 32) {
+            const __m256i chars{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(input + i))};
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                                shiftLettersAVX2(chars, shifts));
+        }
+        return i;
+    }
+
+    __attribute__((target("sse2"))) std::size_t vigenereShiftSSE2(
+        const char* input, char* output, const std::size_t size,
+        const unsigned char* shifts, const std::size_t period,
+        std::size_t phase)
+    {
+        // Each step moves 16 characters along the pattern, which is
+        // equivalent to moving this much within one period
+        const std::size_t step{16 % period};
+        std::size_t i{0};
+        for (; i + 16 <= size; i += 16) {
+            const __m128i chars{_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(input + i))};
+            const __m128i shiftVec{_mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(shifts + phase))};
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                             shiftLettersSSE2(chars, shiftVec));
+            phase += step;
+            if (phase >= period) {
+                phase -= period;
+            }
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) std::size_t vigenereShiftAVX2(
+        const char* input, char* output, const std::size_t size,
+        const unsigned char* shifts, const std::size_t period,
+        std::size_t phase)
+    {
+        const std::size_t step{32 % period};
+        std::size_t i{0};
+        for (; i + 32 <= size; i += 32) {
+            const __m256i chars{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(input + i))};
+            const __m256i shiftVec{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(shifts + phase))};
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                                shiftLettersAVX2(chars, shiftVec));
+            phase += step;
+            if (phase >= period) {
+                phase -= period;
+            }
+        }
+        return i;
+    }
+
+    /// For each mask of 8 bits, the shuffle that moves the bytes whose bits are set to the front
+    constexpr std::array<std::uint64_t, 256> makeCompactShuffles()
+    {
+        std::array<std::uint64_t, 256> shuffles{};
+        for (std::size_t mask{0}; mask < 256; ++mask) {
+            // Unused positions select nothing (the top bit zeroes the byte)
+            std::uint64_t shuffle{0x8080808080808080};
+            std::size_t nKept{0};
+            for (std::uint64_t bit{0}; bit < 8; ++bit) {
+                if (mask & (1u << bit)) {
+                    shuffle &= ~(std::uint64_t{0xff} << (8 * nKept));
+                    shuffle |= bit << (8 * nKept);
+                    ++nKept;
+                }
+            }
+            shuffles[mask] = shuffle;
+        }
+        return shuffles;
+    }
+
+    constexpr std::array<std::uint64_t, 256> compactShuffles{
+        makeCompactShuffles()};
+
+    /// Write the bytes of one 16-byte lane whose bits are set in the mask contiguously to the output
+    __attribute__((target("avx2"))) inline char* compactLane(const __m128i lane,
+                                                   const unsigned mask,
+                                                   char* output)
+    {
+        // Compact each half of the lane separately (adding 8 to the indices
+        // for the upper half, which selects from the upper 8 bytes)
+        const unsigned lowMask{mask & 0xff};
+        const unsigned highMask{mask >> 8};
+        const __m128i shuffle{_mm_set_epi64x(
+            static_cast<long long>(compactShuffles[highMask] +
+                                   0x0808080808080808),
+            static_cast<long long>(compactShuffles[lowMask]))};
+        const __m128i compacted{_mm_shuffle_epi8(lane, shuffle)};
+
+        // Store 8 bytes for each half but only move on past the kept ones
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output), compacted);
+        output += __builtin_popcount(lowMask);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output),
+                         _mm_unpackhi_epi64(compacted, compacted));
+        output += __builtin_popcount(highMask);
+        return output;
+    }
+
+    __attribute__((target("avx2"))) ShiftKernels::Progress
+    transformLettersAVX2(const char* input, char* output,
+                         const std::size_t size)
+    {
+        char* const outputStart{output};
+        std::size_t i{0};
+        for (; i + 32 <= size; i += 32) {
+            const __m256i chars{_mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(input + i))};
+
+            // Digits need expanding, so leave this vector to the caller
+            const __m256i isDigit{_mm256_and_si256(
+                _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chars))};
+            if (!_mm256_testz_si256(isDigit, isDigit)) {
+                break;
+            }
+
+            // Clearing the 0x20 bit uppercases lowercase letters, and a byte
+            // is a letter exactly when the result is in 'A' to 'Z'
+            const __m256i upper{
+                _mm256_and_si256(chars, _mm256_set1_epi8(~0x20))};
+            const __m256i isLetter{_mm256_and_si256(
+                _mm256_cmpgt_epi8(upper, _mm256_set1_epi8('A' - 1)),
+                _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), upper))};
+            const unsigned mask{
+                static_cast<unsigned>(_mm256_movemask_epi8(isLetter))};
+
+            // Then keep only the letters
+            output = compactLane(_mm256_castsi256_si128(upper), mask & 0xffff,
+                                 output);
+            output = compactLane(_mm256_extracti128_si256(upper, 1),
+                                 mask >> 16, output);
+        }
+        return ShiftKernels::Progress{
+            i, static_cast<std::size_t>(output - outputStart)};
+    }
+#endif
+
+    /// Storage for the currently selected kernel
+    std::atomic<ShiftKernels::Kernel>& activeKernelStorage()
+    {
+        static std::atomic<ShiftKernels::Kernel> kernel{
+            ShiftKernels::bestSupported()};
+        return kernel;
+    }
+}    // namespace
+
+namespace ShiftKernels {
+    bool isSupported(const Kernel kernel)
+    {
+        switch (kernel) {
+            case Kernel::Scalar:
+                return true;
+#ifdef MPAGSCIPHER_X86_KERNELS
+            case Kernel::SSE2:
+                return __builtin_cpu_supports("sse2");
+            case Kernel::AVX2:
+                return __builtin_cpu_supports("avx2");
+#else
+            case Kernel::SSE2:
+            case Kernel::AVX2:
+                return false;
+#endif
+        }
+        return false;
+    }
+
+    Kernel bestSupported()
+    {
+        if (isSupported(Kernel::AVX2)) {
+            return Kernel::AVX2;
+        }
+        if (isSupported(Kernel::SSE2)) {
+            return Kernel::SSE2;
+        }
+        return Kernel::Scalar;
+    }
+
+    Kernel activeKernel()
+    {
+        return activeKernelStorage().load(std::memory_order_relaxed);
+    }
+
+    void setActiveKernel(const Kernel kernel)
+    {
+        if (!isSupported(kernel)) {
+            throw UnsupportedKernel("the " + kernelName(kernel) +
+                                    " kernel is not supported by this CPU");
+        }
+        activeKernelStorage().store(kernel, std::memory_order_relaxed);
+    }
+
+    std::string kernelName(const Kernel kernel)
+    {
+        switch (kernel) {
+            case Kernel::Scalar:
+                return "Scalar";
+            case Kernel::SSE2:
+                return "SSE2";
+            case Kernel::AVX2:
+                return "AVX2";
+        }
+        return "Unknown";
+    }
+
+    std::size_t caesarShift(const Kernel kernel,
+                            [[maybe_unused]] const char* input,
+                            [[maybe_unused]] char* output,
+                            [[maybe_unused]] const std::size_t size,
+                            [[maybe_unused]] const std::size_t shift)
+    {
+        switch (kernel) {
+            case Kernel::Scalar:
+                return 0;
+#ifdef MPAGSCIPHER_X86_KERNELS
+            case Kernel::SSE2:
+                return caesarShiftSSE2(input, output, size, shift);
+            case Kernel::AVX2:
+                return caesarShiftAVX2(input, output, size, shift);
+#else
+            case Kernel::SSE2:
+            case Kernel::AVX2:
+                return 0;
+#endif
+        }
+        return 0;
+    }
+
+    std::size_t vigenereShift(const Kernel kernel,
+                              [[maybe_unused]] const char* input,
+                              [[maybe_unused]] char* output,
+                              [[maybe_unused]] const std::size_t size,
+                              [[maybe_unused]] const unsigned char* shifts,
+                              [[maybe_unused]] const std::size_t period,
+                              [[maybe_unused]] const std::size_t phase)
+    {
+        switch (kernel) {
+            case Kernel::Scalar:
+                return 0;
+#ifdef MPAGSCIPHER_X86_KERNELS
+            case Kernel::SSE2:
+                return vigenereShiftSSE2(input, output, size, shifts, period,
+                                         phase);
+            case Kernel::AVX2:
+                return vigenereShiftAVX2(input, output, size, shifts, period,
+                                         phase);
+#else
+            case Kernel::SSE2:
+            case Kernel::AVX2:
+                return 0;
+#endif
+        }
+        return 0;
+    }
+
+    Progress transformLetters(const Kernel kernel,
+                              [[maybe_unused]] const char* input,
+                              [[maybe_unused]] char* output,
+                              [[maybe_unused]] const std::size_t size)
+    {
+        switch (kernel) {
+            case Kernel::Scalar:
+            case Kernel::SSE2:
+                // The byte shuffle needed to compact the letters is not
+                // part of SSE2, so only AVX2 is vectorised
+                return Progress{0, 0};
+#ifdef MPAGSCIPHER_X86_KERNELS
+            case Kernel::AVX2:
+                return transformLettersAVX2(input, output, size);
+#else
+            case Kernel::AVX2:
+                return Progress{0, 0};
+#endif
+        }
+        return Progress{0, 0};
+    }
+}    // namespace ShiftKernels
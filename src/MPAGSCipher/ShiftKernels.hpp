@@ -0,0 +1,154 @@
+#ifndef MPAGSCIPHER_SHIFTKERNELS_HPP
+#define MPAGSCIPHER_SHIFTKERNELS_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+/**
+ * \file ShiftKernels.hpp
+ * \brief Contains the declarations of the vectorised kernels that shift letters around the alphabet
+ * and that prepare the input text for them
+ */
+
+/**
+ * \namespace ShiftKernels
+ * \brief Namespace to hold the vectorised letter-shift kernels and their runtime dispatch
+ *
+ * Each kernel processes as many whole vector-registers' worth of the input as
+ * it can and returns the number of characters it has processed, leaving the
+ * remaining tail for the (table-driven) scalar code in the calling cipher.
+ * Only the characters 'A' to 'Z' are shifted, all other bytes are copied
+ * through unchanged.
+ */
+namespace ShiftKernels {
+    /**
+     * \enum Kernel
+     * \brief The instruction sets for which a kernel is available
+     */
+    enum class Kernel {
+        Scalar,    ///< No vectorisation, everything is left to the caller
+        SSE2,      ///< 16 characters at a time using SSE2
+        AVX2       ///< 32 characters at a time using AVX2
+    };
+
+    /// The widest vector register, in characters, that any kernel uses
+    const std::size_t maxVectorWidth{32};
+
+    /**
+     * \brief Check whether the CPU we are running on supports the given kernel
+     *
+     * \param kernel the kernel to check
+     * \return true if the kernel can be used
+     */
+    bool isSupported(const Kernel kernel);
+
+    /**
+     * \brief Find the fastest kernel supported by the CPU we are running on
+     *
+     * \return the best available kernel
+     */
+    Kernel bestSupported();
+
+    /**
+     * \brief Get the kernel currently used by the ciphers
+     *
+     * This defaults to the result of bestSupported()
+     *
+     * \return the kernel in use
+     */
+    Kernel activeKernel();
+
+    /**
+     * \brief Change the kernel used by the ciphers, e.g. for testing or benchmarking
+     *
+     * \param kernel the kernel to use
+     * \exception UnsupportedKernel if the CPU does not support the kernel
+     */
+    void setActiveKernel(const Kernel kernel);
+
+    /**
+     * \brief Get a printable name for the given kernel
+     *
+     * \param kernel the kernel to name
+     * \return the name of the kernel
+     */
+    std::string kernelName(const Kernel kernel);
+
+    /**
+     * \brief Shift every letter of the input by the same amount
+     *
+     * \param kernel the kernel to use
+     * \param input the characters to shift
+     * \param output where to write the shifted characters (may be the same as input)
+     * \param size the number of characters in the input
+     * \param shift the shift to apply, in the range [0, 26)
+     * \return the number of characters processed, the remainder are left to the caller
+     */
+    std::size_t caesarShift(const Kernel kernel, const char* input,
+                            char* output, const std::size_t size,
+                            const std::size_t shift);
+
+    /**
+     * \brief Shift the letters of the input by a repeating pattern of shifts
+     *
+     * The pattern must be followed in memory by a repeat of its first
+     * maxVectorWidth entries (repeating it again if it is shorter than that),
+     * so that a full vector of shifts can be loaded starting at any position
+     * within one period of the pattern.
+     *
+     * \param kernel the kernel to use
+     * \param input the characters to shift
+     * \param output where to write the shifted characters (may be the same as input)
+     * \param size the number of characters in the input
+     * \param shifts the padded pattern of shifts, each in the range [0, 26)
+     * \param period the length of one repeat of the pattern
+     * \param phase the position in the pattern to use for the first character
+     * \return the number of characters processed, the remainder are left to the caller
+     */
+    std::size_t vigenereShift(const Kernel kernel, const char* input,
+                              char* output, const std::size_t size,
+                              const unsigned char* shifts,
+                              const std::size_t period, const std::size_t phase);
+
+    /**
+     * \struct Progress
+     * \brief How far a kernel got through its input, when its output can be shorter than its input
+     */
+    struct Progress {
+        /// The number of input characters processed
+        std::size_t nRead;
+        /// The number of output characters written
+        std::size_t nWritten;
+    };
+
+    /**
+     * \brief Transliterate the input, as far as the first vector that contains a digit
+     *
+     * Letters are made uppercase and every other byte is discarded, so this
+     * is the same as transformText for input that contains no digits.
+     * Digits need to be expanded to words, so the kernel stops at the first
+     * vector of input that contains one and leaves it to the caller.
+     * Only the AVX2 kernel is vectorised, the others do nothing.
+     *
+     * \param kernel the kernel to use
+     * \param input the characters to transliterate
+     * \param output where to write the result, which must have room for
+     *               the nRead characters processed plus 8 more
+     * \param size the number of characters in the input
+     * \return how many characters were processed and how many written
+     */
+    Progress transformLetters(const Kernel kernel, const char* input,
+                              char* output, const std::size_t size);
+}    // namespace ShiftKernels
+
+/**
+ * \class UnsupportedKernel
+ * \brief Exception thrown when requesting a kernel that the CPU cannot run
+ */
+class UnsupportedKernel : public std::invalid_argument {
+  public:
+    UnsupportedKernel(const std::string& what) : std::invalid_argument(what) {}
+};
+
+#endif    // MPAGSCIPHER_SHIFTKERNELS_HPP
@@ -0,0 +1,64 @@
+#include "StreamCipher.hpp"
+#include "CipherContext.hpp"
+#include "Instrumentation.hpp"
+#include "TransformChar.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    /// Write a block of the result to the stream
+    void writeBlock(std::ostream& outputStream, const char* outputText,
+                    const std::size_t size)
+    {
+        Instrumentation::StageTimer timer{Instrumentation::Stage::Write, size};
+        outputStream.write(outputText, static_cast<std::streamsize>(size));
+        timer.setBytesOut(size);
+    }
+}    // namespace
+
+void applyCipherStream(const Cipher& cipher, std::istream& inputStream,
+                       std::ostream& outputStream, const CipherMode cipherMode,
+                       ThreadPool& pool, const std::size_t blockSize)
+{
+    CipherContext context{cipher.makeContext(cipherMode, &pool)};
+
+    // Buffers for the raw input, its transliteration and the result,
+    // reused for every block
+    std::vector<char> block(blockSize == 0 ? 1 : blockSize);
+    std::string inputText{};
+    std::vector<char> outputText{};
+
+    while (inputStream) {
+        // Read the next block and transliterate it
+        std::size_t nRead{0};
+        {
+            Instrumentation::StageTimer timer{Instrumentation::Stage::Read};
+            inputStream.read(block.data(),
+                             static_cast<std::streamsize>(block.size()));
+            nRead = static_cast<std::size_t>(inputStream.gcount());
+            timer.setBytesOut(nRead);
+        }
+        {
+            Instrumentation::StageTimer timer{
+                Instrumentation::Stage::Transform, nRead};
+            inputText.resize(maxTransformedCharSize * nRead);
+            inputText.resize(transformText(
+                std::string_view{block.data(), nRead}, inputText.data()));
+            timer.setBytesOut(inputText.size());
+        }
+
+        // Cipher and write out as much of it as the context can handle
+        outputText.resize(context.outputBound(inputText.size()));
+        const std::size_t nWritten{
+            context.update(inputText, outputText.data())};
+        writeBlock(outputStream, outputText.data(), nWritten);
+    }
+
+    // The input has ended, so whatever is left is the end of the text
+    outputText.resize(context.outputBound(0) + 1);
+    std::size_t nWritten{context.finalize(outputText.data())};
+    outputText[nWritten++] = '\n';
+    writeBlock(outputStream, outputText.data(), nWritten);
+}
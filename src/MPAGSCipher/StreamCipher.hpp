@@ -0,0 +1,43 @@
+#ifndef MPAGSCIPHER_STREAMCIPHER_HPP
+#define MPAGSCIPHER_STREAMCIPHER_HPP
+
+#include "Cipher.hpp"
+#include "CipherMode.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <iostream>
+
+/**
+ * \file StreamCipher.hpp
+ * \brief Contains the declaration of the function for applying a cipher to a stream of text
+ */
+
+/// The number of characters read from the input stream at a time by default (1 MiB)
+constexpr std::size_t defaultStreamBlockSize{std::size_t{1} << 20};
+
+/**
+ * \brief Apply the cipher to the text read from one stream, writing the result to another
+ *
+ * The input is read in blocks of a fixed size, each of which is
+ * transliterated, ciphered (sharing the work between the threads of the
+ * pool) and written out before the next is read, so the memory used does
+ * not grow with the length of the text.
+ * The blocks are passed through a CipherContext, which carries the state
+ * of the cipher from one block to the next, so the result is the same as
+ * ciphering the whole text at once.
+ * A newline is written after the end of the text.
+ *
+ * \param cipher the cipher to apply
+ * \param inputStream where to read the text to encrypt or decrypt
+ * \param outputStream where to write the result
+ * \param cipherMode whether to encrypt or decrypt the input text
+ * \param pool the workers to use
+ * \param blockSize the number of characters to read from the input at a time
+ */
+void applyCipherStream(const Cipher& cipher, std::istream& inputStream,
+                       std::ostream& outputStream, const CipherMode cipherMode,
+                       ThreadPool& pool,
+                       const std::size_t blockSize = defaultStreamBlockSize);
+
+#endif    // MPAGSCIPHER_STREAMCIPHER_HPP
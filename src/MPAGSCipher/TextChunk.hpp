@@ -0,0 +1,27 @@
+#ifndef MPAGSCIPHER_TEXTCHUNK_HPP
+#define MPAGSCIPHER_TEXTCHUNK_HPP
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * \file TextChunk.hpp
+ * \brief Contains the declaration of the TextChunk struct
+ */
+
+/**
+ * \struct TextChunk
+ * \brief A piece of a larger text, together with where it sits in that text
+ *
+ * Ciphers whose output depends on the position of each character (such as
+ * the Vigenere cipher) use the offset to carry on from the right place,
+ * so that chunks can be processed independently of each other
+ */
+struct TextChunk {
+    /// The characters in this chunk (a view into the whole text)
+    std::string_view text;
+    /// The position of the first character of the chunk in the whole text
+    std::size_t offset;
+};
+
+#endif    // MPAGSCIPHER_TEXTCHUNK_HPP
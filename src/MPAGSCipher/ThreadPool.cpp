@@ -0,0 +1,66 @@
+#include "ThreadPool.hpp"
+#include "Instrumentation.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+ThreadPool::ThreadPool(const std::size_t nThreads)
+{
+    // Default to one worker per hardware thread
+    // (hardware_concurrency may return 0 if it cannot tell)
+    std::size_t nWorkers{nThreads};
+    if (nWorkers == 0) {
+        nWorkers = std::thread::hardware_concurrency();
+    }
+    if (nWorkers == 0) {
+        nWorkers = 1;
+    }
+
+    workers_.reserve(nWorkers);
+    for (std::size_t i{0}; i < nWorkers; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            // Wait until there is something to do
+            std::unique_lock<std::mutex> lock{mutex_};
+            condition_.wait(lock,
+                            [this] { return stopping_ || !tasks_.empty(); });
+
+            // Only stop once all the queued tasks have been run
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        // Only look at the clock if someone is collecting statistics
+        if (Instrumentation::enabled()) {
+            const auto start = std::chrono::steady_clock::now();
+            task();
+            Instrumentation::recordThreadBusy(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start));
+        } else {
+            task();
+        }
+    }
+}
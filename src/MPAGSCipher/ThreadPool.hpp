@@ -0,0 +1,107 @@
+#ifndef MPAGSCIPHER_THREADPOOL_HPP
+#define MPAGSCIPHER_THREADPOOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * \file ThreadPool.hpp
+ * \brief Contains the declaration of the ThreadPool class
+ */
+
+/**
+ * \class ThreadPool
+ * \brief A fixed-size pool of worker threads that run submitted tasks
+ *
+ * The workers are started on construction and live until the pool is
+ * destroyed, so that the cost of creating threads is only paid once
+ * however many tasks are run.
+ *
+ * It can be used as follows:
+ * \code{.cpp}
+ * ThreadPool pool{4};
+ * std::future<int> result{pool.submit([] { return 42; })};
+ * \endcode
+ */
+class ThreadPool {
+  public:
+    /**
+     * \brief Create a new ThreadPool and start its workers
+     *
+     * \param nThreads the number of worker threads, if zero the number of
+     *                 hardware threads is used
+     */
+    explicit ThreadPool(const std::size_t nThreads = 0);
+
+    /// Finish any queued tasks and then stop and join the workers
+    ~ThreadPool();
+
+    /// Copying a pool makes no sense, so forbid it
+    ThreadPool(const ThreadPool& rhs) = delete;
+    /// Nor can a pool (with its running workers) be moved
+    ThreadPool(ThreadPool&& rhs) = delete;
+    /// Copying a pool makes no sense, so forbid it
+    ThreadPool& operator=(const ThreadPool& rhs) = delete;
+    /// Nor can a pool (with its running workers) be moved
+    ThreadPool& operator=(ThreadPool&& rhs) = delete;
+
+    /**
+     * \brief Get the number of worker threads
+     *
+     * \return the number of workers
+     */
+    std::size_t size() const { return workers_.size(); }
+
+    /**
+     * \brief Queue a task to be run by one of the workers
+     *
+     * \param task the callable to run, which takes no arguments
+     * \return a future holding the result of the task (or any exception it throws)
+     */
+    template <typename Task>
+    std::future<std::invoke_result_t<Task>> submit(Task&& task)
+    {
+        using Result = std::invoke_result_t<Task>;
+
+        // std::function needs a copyable callable, so hold the
+        // (move-only) packaged_task through a shared_ptr
+        auto packagedTask = std::make_shared<std::packaged_task<Result()>>(
+            std::forward<Task>(task));
+        std::future<Result> result{packagedTask->get_future()};
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.emplace([packagedTask] { (*packagedTask)(); });
+        }
+        condition_.notify_one();
+        return result;
+    }
+
+  private:
+    /// The worker threads
+    std::vector<std::thread> workers_;
+
+    /// The tasks waiting to be run
+    std::queue<std::function<void()>> tasks_;
+
+    /// Protects the task queue and the stopping flag
+    std::mutex mutex_;
+
+    /// Used to wake the workers when there is a task or we are stopping
+    std::condition_variable condition_;
+
+    /// Set when the pool is being destroyed
+    bool stopping_{false};
+
+    /// The loop run by each worker thread
+    void workerLoop();
+};
+
+#endif    // MPAGSCIPHER_THREADPOOL_HPP
@@ -1,63 +1,117 @@
 #include "TransformChar.hpp"
+#include "ShiftKernels.hpp"
 
-#include <cctype>
+#include <array>
+#include <cstring>
 #include <string>
+#include <string_view>
 
-std::string transformChar(const char inputChar)
-{
-    /* take the input character and transform it according to the following:
-       - Alphabetical characters are converted to uppercase
-       - Digits are translated to their English equivalent words (e.g. '0' -> "ZERO")
-       - All other characters (punctuation) are discarded
+namespace {
 
-     char inputChar: The character to transform
-     
-     return: The string generated by the transformed character
-    */
+/// What a single input character is transliterated to
+struct Expansion {
+    /// The transliterated characters, padded with '\0'
+    std::array<char, maxTransformedCharSize> text;
+    /// The number of characters in the transliteration
+    std::size_t size;
+};
 
-    std::string inputText;
+/// Build the expansion of each possible input character
+constexpr std::array<Expansion, 256> makeExpansionTable()
+{
+    std::array<Expansion, 256> table{};
 
     // Uppercase alphabetic characters
-    if (std::isalpha(inputChar)) {
-        inputText += std::toupper(inputChar);
-        return inputText;
+    for (char c{'A'}; c <= 'Z'; ++c) {
+        table[static_cast<unsigned char>(c)] = Expansion{{c}, 1};
+        table[static_cast<unsigned char>(c - 'A' + 'a')] = Expansion{{c}, 1};
     }
 
     // Transliterate digits to English words
-    switch (inputChar) {
-        case '0':
-            inputText += "ZERO";
-            break;
-        case '1':
-            inputText += "ONE";
-            break;
-        case '2':
-            inputText += "TWO";
-            break;
-        case '3':
-            inputText += "THREE";
-            break;
-        case '4':
-            inputText += "FOUR";
-            break;
-        case '5':
-            inputText += "FIVE";
-            break;
-        case '6':
-            inputText += "SIX";
-            break;
-        case '7':
-            inputText += "SEVEN";
-            break;
-        case '8':
-            inputText += "EIGHT";
-            break;
-        case '9':
-            inputText += "NINE";
-            break;
+    constexpr std::array<std::string_view, 10> digitWords{
+        "ZERO", "ONE", "TWO", "THREE", "FOUR",
+        "FIVE", "SIX", "SEVEN", "EIGHT", "NINE"};
+    for (std::size_t digit{0}; digit < digitWords.size(); ++digit) {
+        Expansion& expansion{table['0' + digit]};
+        for (std::size_t i{0}; i < digitWords[digit].size(); ++i) {
+            expansion.text[i] = digitWords[digit][i];
+        }
+        expansion.size = digitWords[digit].size();
     }
 
     // If the character isn't alphabetic or numeric, DONT add it
+    // (its expansion is left empty)
+
+    return table;
+}
+
+constexpr std::array<Expansion, 256> expansionTable{makeExpansionTable()};
 
-    return inputText;
-}
\ No newline at end of file
+/// Transliterate the text one character at a time using the table
+std::size_t transformTextScalar(const std::string_view inputText,
+                                char* outputText)
+{
+    // Every expansion is copied in full and the output position then only
+    // advanced past its real characters, so there is no need to branch on
+    // the kind of character (the caller's buffer has room for the padding)
+    std::size_t nWritten{0};
+    for (const char inputChar : inputText) {
+        const Expansion& expansion{
+            expansionTable[static_cast<unsigned char>(inputChar)]};
+        std::memcpy(outputText + nWritten, expansion.text.data(),
+                    maxTransformedCharSize);
+        nWritten += expansion.size;
+    }
+    return nWritten;
+}
+
+}    // namespace
+
+std::size_t transformText(const std::string_view inputText, char* outputText)
+{
+    // Let the vectorised kernel deal with as much as it can, which is
+    // everything up to the next vector containing a digit, then expand
+    // that vector (or the final partial one) with the scalar code
+    const ShiftKernels::Kernel kernel{ShiftKernels::activeKernel()};
+    const std::size_t inputSize{inputText.size()};
+    std::size_t nRead{0};
+    std::size_t nWritten{0};
+    while (nRead < inputSize) {
+        const ShiftKernels::Progress progress{ShiftKernels::transformLetters(
+            kernel, inputText.data() + nRead, outputText + nWritten,
+            inputSize - nRead)};
+        nRead += progress.nRead;
+        nWritten += progress.nWritten;
+
+        const std::string_view rest{
+            inputText.substr(nRead, ShiftKernels::maxVectorWidth)};
+        nWritten += transformTextScalar(rest, outputText + nWritten);
+        nRead += rest.size();
+    }
+    return nWritten;
+}
+
+std::size_t transformedLength(const std::string_view inputText)
+{
+    const std::size_t inputSize{inputText.size()};
+    std::size_t nLetters{0};
+    while (nLetters < inputSize && inputText[nLetters] >= 'A' &&
+           inputText[nLetters] <= 'Z') {
+        ++nLetters;
+    }
+    for (std::size_t i{nLetters}; i < inputSize; ++i) {
+        if (expansionTable[static_cast<unsigned char>(inputText[i])].size !=
+            0) {
+            return std::string_view::npos;
+        }
+    }
+    return nLetters;
+}
+
+std::string transformChar(const char inputChar)
+{
+    std::string outputText(maxTransformedCharSize, '\0');
+    outputText.resize(transformText(std::string_view{&inputChar, 1},
+                                    outputText.data()));
+    return outputText;
+}
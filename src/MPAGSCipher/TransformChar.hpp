@@ -1,23 +1,58 @@
 #ifndef MPAGSCIPHER_TRANSFORMCHAR_HPP
 #define MPAGSCIPHER_TRANSFORMCHAR_HPP
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 
 /**
  * \file TransformChar.hpp
- * \brief Contains the declaration of the function for pre-processing the input text
+ * \brief Contains the declaration of the functions for pre-processing the input text
  */
 
+/// The most characters that transliterating a single character can produce (e.g. "THREE")
+constexpr std::size_t maxTransformedCharSize{5};
+
 /**
- * \brief Transliterate char to string
+ * \brief Transliterate a block of text
  *
  * - Alphabet characters are made uppercase
  * - Digits are replaced with their English word equivalents, e.g. '0' -> "ZERO"
  * - All other characters (e.g. punctuation, spaces) are discarded
  *
+ * Each character is looked up in a table rather than classified with the
+ * locale-aware functions from <cctype>, and the result is written straight
+ * into the provided buffer.
+ *
+ * \param inputText the text to process
+ * \param outputText where to write the transliterated text, which must have
+ *                   room for maxTransformedCharSize * inputText.size() characters
+ * \return the number of characters written to the output
+ */
+std::size_t transformText(const std::string_view inputText, char* outputText);
+
+/**
+ * \brief Check whether the text is already in the form that transformText produces
+ *
+ * This is the case for text made up of uppercase letters, followed only by
+ * characters that would be discarded (such as the newline at the end of a
+ * file written by mpags-cipher), and allows such text to be used as it is
+ * without being copied.
+ *
+ * \param inputText the text to check
+ * \return the length of the leading uppercase letters if the text is already
+ *         transliterated, or std::string_view::npos if it is not
+ */
+std::size_t transformedLength(const std::string_view inputText);
+
+/**
+ * \brief Transliterate char to string
+ *
+ * Follows the same rules as transformText
+ *
  * \param inputChar the character to process
  * \return the transliterated string
  */
 std::string transformChar(const char inputChar);
 
-#endif    // MPAGSCIPHER_TRANSFORMCHAR_HPP
\ No newline at end of file
+#endif    // MPAGSCIPHER_TRANSFORMCHAR_HPP
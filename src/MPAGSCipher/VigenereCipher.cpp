@@ -1,9 +1,10 @@
 #include "VigenereCipher.hpp"
 #include "Alphabet.hpp"
+#include "ShiftKernels.hpp"
 
 #include <algorithm>
-#include <iostream>
 #include <string>
+#include <string_view>
 
 VigenereCipher::VigenereCipher(const std::string& key)
 {
@@ -30,53 +31,70 @@ void VigenereCipher::setKey(const std::string& key)
       throw InvalidKey("Vigenere Cipher returns an alphabetic key");
     }
 
-    // Loop through the key
-    charLookup_.clear();
+    // Convert each letter of the key into the shift it represents, once,
+    // so that applying the cipher is just a matter of adding these shifts
+    encryptShifts_.clear();
+    decryptShifts_.clear();
+    encryptShifts_.reserve(key_.size() + ShiftKernels::maxVectorWidth);
+    decryptShifts_.reserve(key_.size() + ShiftKernels::maxVectorWidth);
     for (const char letter : key_) {
-        // Check if we've already seen this letter before
-        // NB C++20 will allow us to be clearer:
-        // if (charLookup_.contains(letter))
-        if (charLookup_.find(letter) != charLookup_.end()) {
-            continue;
-        }
+        // Look up the position of the letter in the alphabet
+        const std::size_t index{Alphabet::index(letter)};
 
-        // Find the position of the letter in the alphabet
-        const std::size_t index{Alphabet::alphabet.find(letter)};
+        encryptShifts_.push_back(static_cast<unsigned char>(index));
+        decryptShifts_.push_back(static_cast<unsigned char>(
+            (Alphabet::size - index) % Alphabet::size));
+    }
 
-        // Construct a Caesar cipher object in-place using the position as the key,
-        // storing it so that it can be retrieved based on the character in the key
-        charLookup_.emplace(std::piecewise_construct, std::make_tuple(letter),
-                            std::make_tuple(index));
+    // Pad the shifts with further repeats of the key, so that the vectorised
+    // kernels can load a whole register of shifts from any key position
+    for (std::size_t i{0}; i < ShiftKernels::maxVectorWidth; ++i) {
+        encryptShifts_.push_back(encryptShifts_[i % key_.size()]);
+        decryptShifts_.push_back(decryptShifts_[i % key_.size()]);
     }
 }
 
-std::string VigenereCipher::applyCipher(const std::string& inputText,
+std::size_t VigenereCipher::applyCipher(const TextChunk& chunk,
+                                        char* outputText,
                                         const CipherMode cipherMode) const
 {
+    const std::string_view inputText{chunk.text};
+
+    // Select the shifts for the requested mode
+    const std::vector<unsigned char>& shifts{
+        (cipherMode == CipherMode::Encrypt) ? encryptShifts_ : decryptShifts_};
+
     // Store the size of the input text and of the key
     const std::size_t inputSize{inputText.size()};
     const std::size_t keySize{key_.size()};
 
-    // Create the output string, reserving space for
-    // as many characters as are in the input text
-    std::string outputText;
-    outputText.reserve(inputSize);
+    // Process as much of the text as possible with the vectorised kernel
+    const std::size_t nDone{ShiftKernels::vigenereShift(
+        ShiftKernels::activeKernel(), inputText.data(), outputText,
+        inputSize, shifts.data(), keySize, chunk.offset % keySize)};
 
-    // Loop through the text
-    for (std::size_t i{0}; i < inputSize; ++i) {
-        // Determine the corresponding character in the key based on the position
-        // (repeating the key if necessary)
-        const char keyChar{key_[i % keySize]};
-
-        // Find the corresponding Caesar cipher
-        const CaesarCipher& cipher{charLookup_.at(keyChar)};
+    // Loop through the rest of the text, stepping through the key alongside
+    // it (repeating the key when we reach its end), starting from the key
+    // position that matches this chunk's place in the whole text
+    std::size_t keyPos{(chunk.offset + nDone) % keySize};
+    for (std::size_t i{nDone}; i < inputSize; ++i) {
+        // Shift letters by the amount given by the current key position,
+        // wrapping back around to the start of the alphabet if necessary,
+        // anything else is passed through unchanged
+        const char origChar{inputText[i]};
+        if (origChar >= 'A' && origChar <= 'Z') {
+            const int shifted{origChar + shifts[keyPos]};
+            outputText[i] = static_cast<char>(
+                (shifted > 'Z') ? shifted - static_cast<int>(Alphabet::size)
+                                : shifted);
+        } else {
+            outputText[i] = origChar;
+        }
 
-        // Use it to encrypt/decrypt the character of the text
-        // and put the new character into the output
-        const std::string oldChar{inputText[i]};
-        outputText += cipher.applyCipher(oldChar, cipherMode);
+        if (++keyPos == keySize) {
+            keyPos = 0;
+        }
     }
 
-    // Return the output text
-    return outputText;
+    return inputSize;
 }
@@ -1,12 +1,13 @@
 #ifndef MPAGSCIPHER_VIGENERECIPHER_HPP
 #define MPAGSCIPHER_VIGENERECIPHER_HPP
 
-#include "CaesarCipher.hpp"
 #include "Cipher.hpp"
 #include "CipherMode.hpp"
+#include "TextChunk.hpp"
 
-#include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**
  * \file VigenereCipher.hpp
@@ -33,22 +34,46 @@ class VigenereCipher : public Cipher {
      */
     void setKey(const std::string& key);
 
+    /// Make the std::string version of applyCipher from the base class visible
+    using Cipher::applyCipher;
+
     /**
-     * \brief Apply the cipher to the provided text
+     * \brief Apply the cipher to a chunk of text, writing the result into the provided buffer
      *
-     * \param inputText the text to encrypt or decrypt
+     * \param chunk the text to encrypt or decrypt, and its offset within the whole text
+     * \param outputText where to write the result, which must have room for
+     *                   outputSize(chunk.text) characters
      * \param cipherMode whether to encrypt or decrypt the input text
-     * \return the result of applying the cipher to the input text
+     * \return the number of characters written to the output
      */
-    std::string applyCipher(const std::string& inputText,
+    std::size_t applyCipher(const TextChunk& chunk, char* outputText,
                             const CipherMode cipherMode) const override;
 
+    /**
+     * \brief The key position is found from each chunk's offset, so the text can be chunked
+     *
+     * \return true
+     */
+    bool supportsChunking() const override { return true; }
+
+    /**
+     * \brief Each character is replaced by exactly one character, so the cipher can be applied in place
+     *
+     * \return true
+     */
+    bool preservesLength() const override { return true; }
+
   private:
     /// The cipher key
     std::string key_{""};
 
-    /// Lookup table to go from the character to the corresponding Caesar cipher
-    std::map<char, CaesarCipher> charLookup_;
+    /// The shift to apply when encrypting, for each position in the key
+    /// (followed by padding for the vectorised kernels)
+    std::vector<unsigned char> encryptShifts_;
+
+    /// The shift to apply when decrypting, for each position in the key
+    /// (followed by padding for the vectorised kernels)
+    std::vector<unsigned char> decryptShifts_;
 };
 
 #endif
\ No newline at end of file
@@ -14,4 +14,21 @@ TEST_CASE("Caesar Cipher decryption", "[caesar]")
 {
     CaesarCipher cc{10};
     REQUIRE(cc.applyCipher("ROVVYGYBVN", CipherMode::Decrypt) == "HELLOWORLD");
-}
\ No newline at end of file
+}
+TEST_CASE("Caesar Cipher round trip for every key", "[caesar]")
+{
+    const std::string alphabet{"ABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+    for (std::size_t key{0}; key < 2 * alphabet.size(); ++key) {
+        CaesarCipher cc{key};
+        const std::string encrypted{
+            cc.applyCipher(alphabet, CipherMode::Encrypt)};
+        REQUIRE(encrypted[0] == alphabet[key % alphabet.size()]);
+        REQUIRE(cc.applyCipher(encrypted, CipherMode::Decrypt) == alphabet);
+    }
+}
+
+TEST_CASE("Caesar Cipher leaves non-alphabet characters unchanged", "[caesar]")
+{
+    CaesarCipher cc{10};
+    REQUIRE(cc.applyCipher("A-b 7", CipherMode::Encrypt) == "K-b 7");
+}
@@ -0,0 +1,63 @@
+//! Unit Tests for MPAGSCipher CaesarCracker
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "CaesarCracker.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+
+namespace {
+    /// Some ordinary English, as it would be after transliteration
+    const std::string plainText{
+        "ITWASTHEBESTOFTIMESITWASTHEWORSTOFTIMESITWASTHEAGEOFWISDOMITWASTHE"
+        "AGEOFFOOLISHNESSITWASTHEEPOCHOFBELIEFITWASTHEEPOCHOFINCREDULITYIT"
+        "WASTHESEASONOFLIGHTITWASTHESEASONOFDARKNESSITWASTHESPRINGOFHOPEIT"
+        "WASTHEWINTEROFDESPAIR"};
+}
+
+TEST_CASE("Letters are counted and everything else ignored", "[caesarcracker]")
+{
+    const auto counts = CaesarCracker::countLetters("ABBA CAB 123 zz!");
+    REQUIRE(counts[0] == 3);
+    REQUIRE(counts[1] == 3);
+    REQUIRE(counts[2] == 1);
+    REQUIRE(counts[25] == 0);
+
+    // Sharing the counting between threads gives the same answer
+    std::string longText;
+    while (longText.size() < (1 << 20)) {
+        longText += plainText + "0123 ";
+    }
+    ThreadPool pool{4};
+    REQUIRE(CaesarCracker::countLetters(longText, pool) ==
+            CaesarCracker::countLetters(longText));
+}
+
+TEST_CASE("Cracking finds the key of Caesar-enciphered English", "[caesarcracker]")
+{
+    ThreadPool pool{2};
+    for (std::size_t key{0}; key < 26; ++key) {
+        const CaesarCipher cipher{key};
+        const std::string cipherText{
+            cipher.applyCipher(plainText, CipherMode::Encrypt)};
+        const auto result = CaesarCracker::crack(cipherText, pool);
+        REQUIRE(result.key == key);
+        REQUIRE(result.nLetters == plainText.size());
+        REQUIRE(cipher.applyCipher(cipherText, CipherMode::Decrypt) ==
+                plainText);
+    }
+}
+
+TEST_CASE("Cracking can look at only the start of the text", "[caesarcracker]")
+{
+    ThreadPool pool{2};
+    const CaesarCipher cipher{11};
+    const std::string cipherText{
+        cipher.applyCipher(plainText, CipherMode::Encrypt) +
+        std::string(1000, 'Q')};
+    REQUIRE(CaesarCracker::crack(cipherText, pool, plainText.size()).key ==
+            11);
+    REQUIRE(CaesarCracker::crack(cipherText, pool, 20).nLetters == 20);
+}
@@ -0,0 +1,82 @@
+//! Unit Tests for MPAGSCipher CipherCache Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CipherCache.hpp"
+#include "CipherFactory.hpp"
+#include "ThreadPool.hpp"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("Cache hands out the same cipher for the same type and key", "[ciphercache]")
+{
+    CipherCache cache{16, 4};
+    const auto first = cache.get(CipherType::Playfair, "hello");
+    const auto second = cache.get(CipherType::Playfair, "hello");
+    REQUIRE(first == second);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 1);
+
+    // The same key for a different cipher is a different entry
+    const auto vigenere = cache.get(CipherType::Vigenere, "hello");
+    REQUIRE(vigenere != first);
+    REQUIRE(cache.misses() == 2);
+    REQUIRE(cache.size() == 2);
+
+    REQUIRE(first->applyCipher("HELLOWORLD", CipherMode::Encrypt) ==
+            cipherFactory(CipherType::Playfair, "hello")
+                ->applyCipher("HELLOWORLD", CipherMode::Encrypt));
+}
+
+TEST_CASE("Cache drops the least recently used cipher when full", "[ciphercache]")
+{
+    CipherCache cache{2, 1};
+    REQUIRE(cache.capacity() == 2);
+    const auto one = cache.get(CipherType::Caesar, "1");
+    cache.get(CipherType::Caesar, "2");
+    // Use "1" again, so that "2" is now the least recently used
+    cache.get(CipherType::Caesar, "1");
+    cache.get(CipherType::Caesar, "3");
+    REQUIRE(cache.size() == 2);
+
+    REQUIRE(cache.get(CipherType::Caesar, "1") == one);
+    const std::uint64_t misses{cache.misses()};
+    cache.get(CipherType::Caesar, "2");
+    REQUIRE(cache.misses() == misses + 1);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.hits() == 0);
+    REQUIRE(cache.misses() == 0);
+}
+
+TEST_CASE("Cache does not keep ciphers with invalid keys", "[ciphercache]")
+{
+    CipherCache cache;
+    REQUIRE_THROWS_AS(cache.get(CipherType::Caesar, "-1"), InvalidKey);
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("Cache can be shared between threads", "[ciphercache]")
+{
+    CipherCache cache{64, 8};
+    ThreadPool pool{4};
+    std::vector<std::future<std::string>> results;
+    for (int i{0}; i < 400; ++i) {
+        results.push_back(pool.submit([&cache, i] {
+            const auto cipher =
+                cache.get(CipherType::Vigenere, "key" + std::to_string(i % 10));
+            return cipher->applyCipher("THEQUICKBROWNFOX", CipherMode::Encrypt);
+        }));
+    }
+    for (int i{0}; i < 400; ++i) {
+        REQUIRE(results[i].get() ==
+                cipherFactory(CipherType::Vigenere, "key" + std::to_string(i % 10))
+                    ->applyCipher("THEQUICKBROWNFOX", CipherMode::Encrypt));
+    }
+    REQUIRE(cache.hits() + cache.misses() == 400);
+    REQUIRE(cache.size() == 10);
+}
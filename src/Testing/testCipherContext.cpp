@@ -0,0 +1,89 @@
+//! Unit Tests for MPAGSCipher CipherContext Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CipherContext.hpp"
+#include "CipherFactory.hpp"
+#include "ThreadPool.hpp"
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Feed the text through the context in pieces of the given size
+std::string applyInPieces(CipherContext& context, const std::string& text,
+                          const std::size_t pieceSize)
+{
+    std::string result;
+    for (std::size_t i{0}; i < text.size(); i += pieceSize) {
+        const std::string_view piece{
+            std::string_view{text}.substr(i, pieceSize)};
+        std::vector<char> output(context.outputBound(piece.size()));
+        const std::size_t nWritten{context.update(piece, output.data())};
+        REQUIRE(nWritten <= output.size());
+        result.append(output.data(), nWritten);
+    }
+    std::vector<char> output(context.outputBound(0));
+    const std::size_t nWritten{context.finalize(output.data())};
+    REQUIRE(nWritten <= output.size());
+    result.append(output.data(), nWritten);
+    return result;
+}
+
+}    // namespace
+
+TEST_CASE("Context gives the same result as applying the cipher at once", "[context]")
+{
+    std::string text;
+    for (std::size_t i{0}; i < 997; ++i) {
+        text += static_cast<char>('A' + (i * 7) % 26);
+        if (i % 11 == 0) {
+            text += "LLL";
+        }
+    }
+
+    ThreadPool pool{3};
+    for (const auto& [type, key] :
+         {std::make_pair(CipherType::Caesar, "17"),
+          std::make_pair(CipherType::Playfair, "hello"),
+          std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+            const std::string expected{cipher->applyCipher(text, mode)};
+            for (std::size_t pieceSize : {1, 2, 5, 64, 5000}) {
+                CipherContext context{cipher->makeContext(mode)};
+                REQUIRE(applyInPieces(context, text, pieceSize) == expected);
+
+                CipherContext parallelContext{
+                    cipher->makeContext(mode, &pool)};
+                REQUIRE(applyInPieces(parallelContext, text, pieceSize) ==
+                        expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Context holds back an unpaired Playfair letter until finalized", "[context]")
+{
+    const auto cipher = cipherFactory(CipherType::Playfair, "hello");
+    CipherContext context{cipher->makeContext(CipherMode::Encrypt)};
+
+    std::vector<char> output(context.outputBound(3));
+    REQUIRE(context.update("BOB", output.data()) == 2);
+    output.resize(context.outputBound(0));
+    REQUIRE(context.finalize(output.data()) == 2);
+}
+
+TEST_CASE("Context can be reused after being finalized", "[context]")
+{
+    const auto cipher = cipherFactory(CipherType::Vigenere, "key");
+    CipherContext context{cipher->makeContext(CipherMode::Encrypt)};
+    const std::string text{"HELLOWORLD"};
+    const std::string first{applyInPieces(context, text, 3)};
+    const std::string second{applyInPieces(context, text, 4)};
+    REQUIRE(first == cipher->applyCipher(text, CipherMode::Encrypt));
+    REQUIRE(second == first);
+}
@@ -3,12 +3,15 @@
 #include "catch.hpp"
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "Cipher.hpp"
 #include "CipherFactory.hpp"
 #include "CipherMode.hpp"
 #include "CipherType.hpp"
+#include "TextChunk.hpp"
 
 bool testCipher(const Cipher& cipher, const CipherMode mode,
                 const std::string& inputText, const std::string& outputText)
@@ -50,4 +53,136 @@ TEST_CASE("Cipher encryption/decryption", "[ciphers]")
         REQUIRE(testCipher(*ciphers[i], CipherMode::Decrypt, cipherText[i],
                            decryptText[i]));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Splitting text into chunks", "[ciphers]")
+{
+    const auto cipher = cipherFactory(CipherType::Caesar, "1");
+    const std::string text{"ABCDEFGHIJ"};
+
+    for (std::size_t n{1}; n <= 12; ++n) {
+        const std::vector<TextChunk> chunks{cipher->splitString(text, n)};
+        REQUIRE(chunks.size() <= n);
+
+        // The chunks must exactly cover the text, with no overlaps
+        std::string joined;
+        for (const auto& chunk : chunks) {
+            REQUIRE(!chunk.text.empty());
+            REQUIRE(chunk.offset == joined.size());
+            REQUIRE(chunk.text.data() == text.data() + chunk.offset);
+            joined += chunk.text;
+        }
+        REQUIRE(joined == text);
+    }
+}
+
+TEST_CASE("Applying ciphers into a caller-provided buffer", "[ciphers]")
+{
+    const std::string text{"BOBISSOMESORTOFJUNIORCOMPLEXXENOPHONE"};
+    for (const auto& [type, key] :
+         {std::make_pair(CipherType::Caesar, "10"),
+          std::make_pair(CipherType::Playfair, "hello"),
+          std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+            const std::string expected{cipher->applyCipher(text, mode)};
+            REQUIRE(cipher->outputSize(text) == expected.size());
+
+            std::vector<char> buffer(cipher->outputSize(text));
+            const std::size_t nWritten{
+                cipher->applyCipher(TextChunk{text, 0}, buffer.data(), mode)};
+            REQUIRE(std::string(buffer.data(), nWritten) == expected);
+        }
+    }
+}
+
+TEST_CASE("Chunked application with offsets matches the whole text", "[ciphers]")
+{
+    const std::string text{
+        "THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES"};
+    for (const auto& [type, key] :
+         {std::make_pair(CipherType::Caesar, "10"),
+          std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        REQUIRE(cipher->supportsChunking());
+        for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+            const std::string expected{cipher->applyCipher(text, mode)};
+            for (std::size_t n{1}; n <= 9; ++n) {
+                std::string joined;
+                for (const auto& chunk : cipher->splitString(text, n)) {
+                    std::string output(cipher->outputSize(chunk.text), '\0');
+                    cipher->applyCipher(chunk, output.data(), mode);
+                    joined += output;
+                }
+                REQUIRE(joined == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("Length-preserving ciphers can be applied in place", "[ciphers]")
+{
+    const std::string text{"THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG"};
+
+    for (const auto& [type, key] : {std::make_pair(CipherType::Caesar, "17"),
+                                    std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        REQUIRE(cipher->preservesLength());
+        for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+            const std::string expected{cipher->applyCipher(text, mode)};
+
+            std::string buffer{text};
+            cipher->applyCipherInPlace(buffer.data(), buffer.size(), mode);
+            REQUIRE(buffer == expected);
+
+            // Applying it to the second half carries on from its offset
+            std::string secondHalf{text.substr(10)};
+            cipher->applyCipherInPlace(secondHalf.data(), secondHalf.size(),
+                                       mode, 10);
+            REQUIRE(secondHalf == expected.substr(10));
+        }
+    }
+}
+
+TEST_CASE("Playfair cipher cannot be applied in place", "[ciphers]")
+{
+    const auto cipher = cipherFactory(CipherType::Playfair, "hello");
+    REQUIRE_FALSE(cipher->preservesLength());
+    std::string buffer{"HELLOWORLD"};
+    REQUIRE_THROWS_AS(cipher->applyCipherInPlace(buffer.data(), buffer.size(),
+                                                 CipherMode::Encrypt),
+                      InPlaceNotSupported);
+}
+
+TEST_CASE("Batches of messages match ciphering each message on its own", "[ciphers]")
+{
+    const std::vector<std::string> messages{"HELLOWORLD", "", "BOBISSOMESORTOFJUNIOR",
+                                            "A", "THISISQUITEALONGMESSAGE"};
+    std::string buffer;
+    std::vector<std::size_t> offsets;
+    for (const auto& message : messages) {
+        offsets.push_back(buffer.size());
+        buffer += message;
+    }
+    offsets.push_back(buffer.size());
+
+    for (const auto& [type, key] : {std::make_pair(CipherType::Caesar, "10"),
+                                    std::make_pair(CipherType::Playfair, "hello"),
+                                    std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+            std::string output(cipher->batchOutputSize(offsets), '\0');
+            std::vector<std::size_t> outputOffsets;
+            const std::size_t nWritten{cipher->applyCipherBatch(
+                buffer, offsets, output.data(), outputOffsets, mode)};
+
+            REQUIRE(outputOffsets.size() == offsets.size());
+            REQUIRE(outputOffsets.back() == nWritten);
+            for (std::size_t i{0}; i < messages.size(); ++i) {
+                REQUIRE(output.substr(outputOffsets[i],
+                                      outputOffsets[i + 1] - outputOffsets[i]) ==
+                        cipher->applyCipher(messages[i], mode));
+            }
+        }
+    }
+}
@@ -0,0 +1,62 @@
+//! Unit Tests for MPAGSCipher compile-time keyed CaesarKernel and VigenereKernel Classes
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "FixedKeyCiphers.hpp"
+#include "VigenereCipher.hpp"
+
+#include <string>
+
+namespace {
+    /// Uppercase letters mixed with other bytes, which must be left alone
+    const std::string mixedText{
+        "THEQUICK BROWN@FOX[JUMPS]OVER\x80THE\xFFLAZY DOG 0123456789 "
+        "ZZZZAAAAMMMMNNNN"};
+}
+
+TEST_CASE("Caesar kernel matches the runtime-keyed Caesar cipher", "[fixedkey]")
+{
+    static_assert(shiftLetter('Z', 1) == 'A');
+    static_assert(shiftLetter('a', 1) == 'a');
+    static_assert(CaesarKernel<27>::encryptShift == 1);
+    static_assert(CaesarKernel<0>::decryptShift == 0);
+
+    const CaesarKernel<13> rot13;
+    const CaesarCipher runtime{13};
+    REQUIRE(rot13.applyCipher("HELLOWORLD", CipherMode::Encrypt) ==
+            "URYYBJBEYQ");
+    for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+        REQUIRE(rot13.applyCipher(mixedText, mode) ==
+                runtime.applyCipher(mixedText, mode));
+    }
+
+    const CaesarKernel<55> wrapped;
+    const CaesarCipher wrappedRuntime{55};
+    REQUIRE(wrapped.applyCipher(mixedText, CipherMode::Decrypt) ==
+            wrappedRuntime.applyCipher(mixedText, CipherMode::Decrypt));
+}
+
+TEST_CASE("Vigenere kernel matches the runtime-keyed Vigenere cipher", "[fixedkey]")
+{
+    const VigenereKernel<'H', 'E', 'L', 'L', 'O'> cipher;
+    const VigenereCipher runtime{"hello"};
+    REQUIRE(cipher.applyCipher(
+                "THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES",
+                CipherMode::Encrypt) ==
+            "ALTDWZUFTHLEWZBNQPDGHKPDCALPVSFATWZUIPOHVVPASHXLQSDXTXSZ");
+
+    for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+        const std::string expected{runtime.applyCipher(mixedText, mode)};
+        REQUIRE(cipher.applyCipher(mixedText, mode) == expected);
+
+        // Chunks starting part of the way through the key carry on correctly
+        for (std::size_t offset{0}; offset < 12; ++offset) {
+            const std::string_view rest{
+                std::string_view{mixedText}.substr(offset)};
+            std::string output(rest.size(), '\0');
+            cipher.applyCipher(TextChunk{rest, offset}, output.data(), mode);
+            REQUIRE(output == expected.substr(offset));
+        }
+    }
+}
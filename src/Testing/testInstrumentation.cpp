@@ -0,0 +1,57 @@
+//! Unit Tests for MPAGSCipher Instrumentation
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "Instrumentation.hpp"
+
+#include <sstream>
+#include <string>
+
+TEST_CASE("Nothing is recorded unless enabled", "[instrumentation]")
+{
+    Instrumentation::reset();
+    Instrumentation::enable(false);
+    {
+        Instrumentation::StageTimer timer{Instrumentation::Stage::Cipher, 10};
+        timer.setBytesOut(10);
+    }
+    std::ostringstream json;
+    Instrumentation::writeJson(json);
+    REQUIRE(json.str().find("\"bytes_in\": 10") == std::string::npos);
+}
+
+TEST_CASE("Stage timers record calls and bytes", "[instrumentation]")
+{
+    if (!Instrumentation::compiledIn()) {
+        return;
+    }
+    Instrumentation::reset();
+    Instrumentation::enable(true);
+    REQUIRE(Instrumentation::enabled());
+    for (int i{0}; i < 2; ++i) {
+        Instrumentation::StageTimer timer{Instrumentation::Stage::Transform,
+                                          100};
+        timer.setBytesOut(123);
+    }
+    Instrumentation::recordChunks(4);
+    Instrumentation::enable(false);
+
+    std::ostringstream json;
+    Instrumentation::writeJson(json);
+    const std::string document{json.str()};
+    REQUIRE(document.find("\"stages\"") != std::string::npos);
+    REQUIRE(document.find("\"transform\": {\"calls\": 2,") != std::string::npos);
+    REQUIRE(document.find("\"bytes_in\": 200, \"bytes_out\": 246") !=
+            std::string::npos);
+    REQUIRE(document.find("\"splits\": 1,") != std::string::npos);
+    REQUIRE(document.find("\"chunks\": 4,") != std::string::npos);
+
+    std::ostringstream summary;
+    Instrumentation::printSummary(summary);
+    REQUIRE(summary.str().rfind("[stats] ", 0) == 0);
+
+    Instrumentation::reset();
+    std::ostringstream cleared;
+    Instrumentation::writeJson(cleared);
+    REQUIRE(cleared.str().find("\"calls\": 2") == std::string::npos);
+}
@@ -0,0 +1,89 @@
+//! Unit Tests for MPAGSCipher MappedFile Class
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "MappedFile.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+
+namespace {
+    /// Write a file with the given contents
+    void writeFile(const std::string& path, const std::string& contents)
+    {
+        std::ofstream file{path, std::ios::binary};
+        file << contents;
+    }
+
+    /// Read the whole of a file
+    std::string readFile(const std::string& path)
+    {
+        std::ifstream file{path, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>{file}, {}};
+    }
+}    // namespace
+
+TEST_CASE("Mapped file is readable", "[mappedfile]")
+{
+    if (!MappedFile::supported) {
+        return;
+    }
+    const std::string path{"testMappedFile_read.txt"};
+    writeFile(path, "HELLOWORLD\n");
+    {
+        const MappedFile file{MappedFile::openForReading(path)};
+        REQUIRE(file.size() == 11);
+        REQUIRE(std::string{file.data(), file.size()} == "HELLOWORLD\n");
+        REQUIRE(file.refersTo(path));
+        REQUIRE_FALSE(file.refersTo("testMappedFile_missing.txt"));
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Empty mapped file has no data", "[mappedfile]")
+{
+    if (!MappedFile::supported) {
+        return;
+    }
+    const std::string path{"testMappedFile_empty.txt"};
+    writeFile(path, "");
+    {
+        const MappedFile file{MappedFile::openForReading(path)};
+        REQUIRE(file.size() == 0);
+        REQUIRE(file.data() == nullptr);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Mapped file is writable and can be truncated", "[mappedfile]")
+{
+    if (!MappedFile::supported) {
+        return;
+    }
+    const std::string path{"testMappedFile_write.txt"};
+    {
+        MappedFile file{MappedFile::createForWriting(path, 20)};
+        REQUIRE(file.size() == 20);
+        const std::string text{"ABCDE\n"};
+        std::copy(text.begin(), text.end(), file.data());
+        file.truncate(text.size());
+        REQUIRE(file.size() == text.size());
+
+        // Moving hands over the mapping without unmapping it
+        MappedFile moved{std::move(file)};
+        REQUIRE(moved.size() == text.size());
+        REQUIRE(moved.data()[0] == 'A');
+    }
+    REQUIRE(readFile(path) == "ABCDE\n");
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Mapping a missing file throws", "[mappedfile]")
+{
+    REQUIRE_THROWS_AS(MappedFile::openForReading("testMappedFile_missing.txt"),
+                      FileError);
+}
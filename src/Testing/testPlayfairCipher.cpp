@@ -12,4 +12,80 @@ TEST_CASE("Playfair Cipher encryption", "[playfair]") {
 TEST_CASE("Playfair Cipher decryption", "[playfair]") {
   PlayfairCipher cc{"hello"};
   REQUIRE( cc.applyCipher("FHIQXLTLKLTLSUFNPQPKETFENIOLVSWLTFIAFTLAKOWATEQOKPPA", CipherMode::Decrypt) == "BOBISXSOMESORTOFIUNIORCOMPLEXQXENOPHONEONEZEROTHINGZ");
-}
\ No newline at end of file
+}
+TEST_CASE("Playfair Cipher row, column and rectangle rules", "[playfair]") {
+  // Grid for the key "playfair example" is:
+  // P L A Y F
+  // I R E X M
+  // B C D G H
+  // K N O Q S
+  // T U V W Z
+  PlayfairCipher cc{"playfair example"};
+  REQUIRE( cc.applyCipher("PLFP", CipherMode::Encrypt) == "LAPL" );
+  REQUIRE( cc.applyCipher("PIBT", CipherMode::Encrypt) == "IBKP" );
+  REQUIRE( cc.applyCipher("HIDE", CipherMode::Encrypt) == "BMOD" );
+  REQUIRE( cc.applyCipher("BMOD", CipherMode::Decrypt) == "HIDE" );
+}
+
+TEST_CASE("Playfair Cipher rejects non-alphabet characters", "[playfair]") {
+  PlayfairCipher cc{"hello"};
+  REQUIRE_THROWS_AS( cc.applyCipher("AB1D", CipherMode::Encrypt), std::out_of_range );
+}
+
+TEST_CASE("Playfair Cipher digraph tables give the same result as the rules", "[playfair]") {
+  PlayfairCipher withTables{"playfair example", true};
+  PlayfairCipher withoutTables{"playfair example", false};
+
+  // Every possible pair of letters, which needs no padding
+  std::string text;
+  const std::string letters{"ABCDEFGHIKLMNOPQRSTUVWXYZ"};
+  for (const char first : letters) {
+    for (const char second : letters) {
+      if (first != second) {
+        text += first;
+        text += second;
+      }
+    }
+  }
+
+  for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+    REQUIRE( withTables.applyCipher(text, mode) == withoutTables.applyCipher(text, mode) );
+  }
+}
+
+TEST_CASE("Playfair Cipher padding rules", "[playfair]") {
+  // Use the decrypt of the encrypt to see the padded plaintext
+  PlayfairCipher cc{"hello"};
+  const auto roundTrip = [&cc](const std::string& text) {
+    return cc.applyCipher(cc.applyCipher(text, CipherMode::Encrypt), CipherMode::Decrypt);
+  };
+  REQUIRE( roundTrip("") == "" );
+  REQUIRE( roundTrip("A") == "AZ" );
+  REQUIRE( roundTrip("Z") == "ZX" );
+  REQUIRE( roundTrip("AAA") == "AXAXAZ" );
+  REQUIRE( roundTrip("XX") == "XQXZ" );
+  REQUIRE( roundTrip("IJ") == "IXIZ" );
+  REQUIRE( roundTrip("ABBC") == "ABBC" );
+}
+
+TEST_CASE("Playfair Cipher chunks start at digraph boundaries", "[playfair]") {
+  PlayfairCipher cc{"hello"};
+  // Plenty of repeated letters (including I/J and X) to shift the digraph alignment
+  const std::string text{"AABBBCIJJIXXXYZZZZQRSTTTUVWXXJKLLLMNOPPPQZ"};
+  for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+    const std::string expected{cc.applyCipher(text, mode)};
+    for (std::size_t n{1}; n <= text.size() + 1; ++n) {
+      std::string joined;
+      std::size_t expectedOffset{0};
+      for (const auto& chunk : cc.splitString(text, n)) {
+        REQUIRE( chunk.offset == expectedOffset );
+        expectedOffset += chunk.text.size();
+        std::string output(cc.outputSize(chunk.text), '\0');
+        cc.applyCipher(chunk, output.data(), mode);
+        joined += output;
+      }
+      REQUIRE( expectedOffset == text.size() );
+      REQUIRE( joined == expected );
+    }
+  }
+}
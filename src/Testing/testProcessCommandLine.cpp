@@ -45,7 +45,7 @@ TEST_CASE("Key entered with no key specified")
     ProgramSettings settings{
         false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
     const std::vector<std::string> cmdLine{"mpags-cipher", "-k"};
-   REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), MissingArgument);
 }
 
 TEST_CASE("Key entered with key specified")
@@ -62,7 +62,7 @@ TEST_CASE("Input file declared without using input file")
     ProgramSettings settings{
         false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
     const std::vector<std::string> cmdLine{"mpags-cipher", "-i"};
-   REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), MissingArgument);
 }
 
 TEST_CASE("Input file declared")
@@ -79,7 +79,7 @@ TEST_CASE("Output file declared without specifying output file")
     ProgramSettings settings{
         false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
     const std::vector<std::string> cmdLine{"mpags-cipher", "-o"};
-   REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), MissingArgument);
 }
 
 TEST_CASE("Output file declared")
@@ -96,7 +96,7 @@ TEST_CASE("Cipher type declared without specifying cipher")
     ProgramSettings settings{
         false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
     const std::vector<std::string> cmdLine{"mpags-cipher", "-c"};
-   REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), MissingArgument);
 }
 
 TEST_CASE("Cipher type declared with unknown cipher")
@@ -104,7 +104,7 @@ TEST_CASE("Cipher type declared with unknown cipher")
     ProgramSettings settings{
         false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
     const std::vector<std::string> cmdLine{"mpags-cipher", "-c", "rubbish"};
-    REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), UnknownArgument);
 }
 
 TEST_CASE("Cipher type declared with Caesar cipher")
@@ -124,3 +124,94 @@ TEST_CASE("Cipher type declared with Playfair cipher")
     REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
     REQUIRE(settings.cipherType == CipherType::Playfair);
 }
+
+TEST_CASE("Number of threads declared")
+{
+    ProgramSettings settings{
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--threads", "8"};
+    REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE(settings.nThreads == 8);
+}
+
+TEST_CASE("Number of threads defaults to hardware concurrency")
+{
+    ProgramSettings settings{
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+    const std::vector<std::string> cmdLine{"mpags-cipher"};
+    REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE(settings.nThreads == 0);
+}
+
+TEST_CASE("Number of threads declared without specifying number")
+{
+    ProgramSettings settings{
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--threads"};
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), MissingArgument);
+}
+
+TEST_CASE("Number of threads declared with invalid number")
+{
+    for (const std::string nThreads : {"0", "-2", "four", "3.5", ""}) {
+        ProgramSettings settings{
+            false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+        const std::vector<std::string> cmdLine{"mpags-cipher", "--threads",
+                                               nThreads};
+        REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings),
+                          InvalidArgument);
+    }
+}
+
+TEST_CASE("Stream mode declared")
+{
+    ProgramSettings settings{
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+    REQUIRE_FALSE(settings.streamMode);
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--stream"};
+    REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE(settings.streamMode);
+}
+
+TEST_CASE("Statistics declared")
+{
+    ProgramSettings settings{
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--stats",
+                                           "--stats-file", "stats.json"};
+    REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE(settings.statsRequested);
+    REQUIRE(settings.statsFile == "stats.json");
+}
+
+TEST_CASE("Statistics file declared without a filename")
+{
+    ProgramSettings settings{
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--stats-file"};
+    REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings), MissingArgument);
+}
+
+TEST_CASE("Crack mode declared")
+{
+    ProgramSettings settings{
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+    REQUIRE_FALSE(settings.crackRequested);
+    const std::vector<std::string> cmdLine{"mpags-cipher", "--crack",
+                                           "--crack-sample", "64"};
+    REQUIRE_NOTHROW(processCommandLine(cmdLine, settings));
+    REQUIRE(settings.crackRequested);
+    REQUIRE(settings.crackSampleKB == 64);
+}
+
+TEST_CASE("Crack sample size declared with invalid number")
+{
+    for (const std::string sampleKB : {"0", "-2", "lots", ""}) {
+        ProgramSettings settings{
+            false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+        const std::vector<std::string> cmdLine{"mpags-cipher", "--crack-sample",
+                                               sampleKB};
+        REQUIRE_THROWS_AS(processCommandLine(cmdLine, settings),
+                          InvalidArgument);
+    }
+}
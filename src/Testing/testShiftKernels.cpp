@@ -0,0 +1,161 @@
+//! Unit Tests for MPAGSCipher ShiftKernels
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CaesarCipher.hpp"
+#include "ShiftKernels.hpp"
+#include "TransformChar.hpp"
+#include "VigenereCipher.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+    /// All the kernels that can be run on this machine
+    std::vector<ShiftKernels::Kernel> supportedKernels()
+    {
+        std::vector<ShiftKernels::Kernel> kernels;
+        for (const auto kernel :
+             {ShiftKernels::Kernel::Scalar, ShiftKernels::Kernel::SSE2,
+              ShiftKernels::Kernel::AVX2}) {
+            if (ShiftKernels::isSupported(kernel)) {
+                kernels.push_back(kernel);
+            }
+        }
+        return kernels;
+    }
+
+    /// Text containing every letter plus some bytes that must not be shifted
+    std::string mixedText(const std::size_t size)
+    {
+        const std::string source{
+            "THEQUICKBROWNFOXJUMPSOVERTHELAZYDOG@[az09 \xff\x80"};
+        std::string text;
+        for (std::size_t i{0}; i < size; ++i) {
+            text += source[(i * 7) % source.size()];
+        }
+        return text;
+    }
+}    // namespace
+
+TEST_CASE("Scalar kernel is always supported", "[kernels]")
+{
+    REQUIRE(ShiftKernels::isSupported(ShiftKernels::Kernel::Scalar));
+    REQUIRE(ShiftKernels::isSupported(ShiftKernels::bestSupported()));
+}
+
+TEST_CASE("Kernels report the number of characters processed", "[kernels]")
+{
+    const std::string text{mixedText(100)};
+    std::string output(text.size(), '\0');
+    for (const auto kernel : supportedKernels()) {
+        const std::size_t nDone{ShiftKernels::caesarShift(
+            kernel, text.data(), output.data(), text.size(), 3)};
+        if (kernel == ShiftKernels::Kernel::Scalar) {
+            REQUIRE(nDone == 0);
+        } else {
+            REQUIRE(nDone <= text.size());
+            REQUIRE(text.size() - nDone < 32);
+        }
+    }
+}
+
+TEST_CASE("Caesar Cipher output is identical for every kernel", "[kernels]")
+{
+    const auto original = ShiftKernels::activeKernel();
+
+    for (std::size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 100, 1000}) {
+        const std::string text{mixedText(size)};
+        for (std::size_t key{0}; key < 26; ++key) {
+            const CaesarCipher cc{key};
+
+            ShiftKernels::setActiveKernel(ShiftKernels::Kernel::Scalar);
+            const std::string encrypted{
+                cc.applyCipher(text, CipherMode::Encrypt)};
+            const std::string decrypted{
+                cc.applyCipher(text, CipherMode::Decrypt)};
+
+            for (const auto kernel : supportedKernels()) {
+                ShiftKernels::setActiveKernel(kernel);
+                REQUIRE(cc.applyCipher(text, CipherMode::Encrypt) ==
+                        encrypted);
+                REQUIRE(cc.applyCipher(text, CipherMode::Decrypt) ==
+                        decrypted);
+            }
+        }
+    }
+
+    ShiftKernels::setActiveKernel(original);
+}
+
+TEST_CASE("Vigenere Cipher output is identical for every kernel", "[kernels]")
+{
+    const auto original = ShiftKernels::activeKernel();
+
+    for (std::size_t keySize : {1, 5, 15, 16, 17, 31, 32, 33, 1000}) {
+        // Build a key of the requested length from the mixed text letters
+        std::string key;
+        for (const char c : mixedText(4 * keySize)) {
+            if (c >= 'A' && c <= 'Z' && key.size() < keySize) {
+                key += c;
+            }
+        }
+        const VigenereCipher vc{key};
+
+        for (std::size_t size : {0, 1, 31, 32, 33, 100, 1000, 3000}) {
+            const std::string text{mixedText(size)};
+
+            ShiftKernels::setActiveKernel(ShiftKernels::Kernel::Scalar);
+            const std::string encrypted{
+                vc.applyCipher(text, CipherMode::Encrypt)};
+            const std::string decrypted{
+                vc.applyCipher(text, CipherMode::Decrypt)};
+
+            for (const auto kernel : supportedKernels()) {
+                ShiftKernels::setActiveKernel(kernel);
+                REQUIRE(vc.applyCipher(text, CipherMode::Encrypt) ==
+                        encrypted);
+                REQUIRE(vc.applyCipher(text, CipherMode::Decrypt) ==
+                        decrypted);
+            }
+        }
+    }
+
+    ShiftKernels::setActiveKernel(original);
+}
+
+TEST_CASE("Transliteration is identical for every kernel", "[kernels]")
+{
+    const auto original = ShiftKernels::activeKernel();
+
+    // Every byte value, then runs of letters and punctuation without digits
+    // (which the vectorised kernel handles) between occasional digits
+    std::string text;
+    for (int c{0}; c < 256; ++c) {
+        text += static_cast<char>(c);
+    }
+    const std::string letters{"The quick, brown fox jumps over the lazy dog!\n"};
+    for (std::size_t i{0}; i < 3000; ++i) {
+        text += letters[(i * 7) % letters.size()];
+        if (i % 500 == 499) {
+            text += static_cast<char>('0' + i % 10);
+        }
+    }
+
+    for (std::size_t start : {0, 1, 31, 256, 257}) {
+        const std::string input{text.substr(start)};
+        std::string expected;
+        for (const char c : input) {
+            expected += transformChar(c);
+        }
+
+        for (const auto kernel : supportedKernels()) {
+            ShiftKernels::setActiveKernel(kernel);
+            std::string output(maxTransformedCharSize * input.size(), '\0');
+            output.resize(transformText(input, output.data()));
+            REQUIRE(output == expected);
+        }
+    }
+
+    ShiftKernels::setActiveKernel(original);
+}
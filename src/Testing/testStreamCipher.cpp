@@ -0,0 +1,76 @@
+//! Unit Tests for applying MPAGSCipher ciphers to streams of text
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CipherFactory.hpp"
+#include "PlayfairCipher.hpp"
+#include "StreamCipher.hpp"
+#include "ThreadPool.hpp"
+#include "TransformChar.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+
+TEST_CASE("Playfair cipher only completes digraphs of two different letters", "[stream]")
+{
+    PlayfairCipher cipher{"hello"};
+    REQUIRE(cipher.completeLength("") == 0);
+    REQUIRE(cipher.completeLength("A") == 0);
+    REQUIRE(cipher.completeLength("AB") == 2);
+    REQUIRE(cipher.completeLength("ABC") == 2);
+    REQUIRE(cipher.completeLength("AAB") == 3);
+    REQUIRE(cipher.completeLength("ABB") == 2);
+    REQUIRE(cipher.completeLength("ABBB") == 2);
+    REQUIRE(cipher.completeLength("ABJI") == 2);
+}
+
+TEST_CASE("Streamed application gives the same result as reading all the text", "[stream]")
+{
+    // Raw input including characters that get dropped or transliterated,
+    // and repeated letters that the Playfair cipher must pad
+    std::string rawText;
+    for (std::size_t i{0}; i < 1009; ++i) {
+        rawText += static_cast<char>('a' + (i * 7) % 26);
+        if (i % 13 == 0) {
+            rawText += "  LL 7,";
+        }
+        if (i % 29 == 0) {
+            rawText += "eEe\n";
+        }
+    }
+    std::string text;
+    for (const char c : rawText) {
+        text += transformChar(c);
+    }
+
+    for (const auto& [type, key] :
+         {std::make_pair(CipherType::Caesar, "17"),
+          std::make_pair(CipherType::Playfair, "hello"),
+          std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        for (std::size_t nThreads : {1, 3}) {
+            ThreadPool pool{nThreads};
+            for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+                for (std::size_t blockSize : {1, 2, 3, 64, 100000}) {
+                    std::istringstream input{rawText};
+                    std::ostringstream output;
+                    applyCipherStream(*cipher, input, output, mode, pool,
+                                      blockSize);
+                    REQUIRE(output.str() ==
+                            cipher->applyCipher(text, mode) + "\n");
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Streamed application of an empty input writes an empty line", "[stream]")
+{
+    const auto cipher = cipherFactory(CipherType::Playfair, "hello");
+    ThreadPool pool{2};
+    std::istringstream input{""};
+    std::ostringstream output;
+    applyCipherStream(*cipher, input, output, CipherMode::Encrypt, pool);
+    REQUIRE(output.str() == "\n");
+}
@@ -0,0 +1,106 @@
+//! Unit Tests for MPAGSCipher ThreadPool Class and parallel cipher application
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "CipherFactory.hpp"
+#include "ParallelCipher.hpp"
+#include "ThreadPool.hpp"
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Thread pool has the requested number of workers", "[threadpool]")
+{
+    ThreadPool pool{3};
+    REQUIRE(pool.size() == 3);
+
+    ThreadPool defaultPool;
+    REQUIRE(defaultPool.size() >= 1);
+}
+
+TEST_CASE("Thread pool runs every task and returns its result", "[threadpool]")
+{
+    ThreadPool pool{4};
+    std::vector<std::future<int>> results;
+    for (int i{0}; i < 100; ++i) {
+        results.push_back(pool.submit([i] { return i * i; }));
+    }
+    for (int i{0}; i < 100; ++i) {
+        REQUIRE(results[i].get() == i * i);
+    }
+}
+
+TEST_CASE("Thread pool finishes queued tasks before being destroyed", "[threadpool]")
+{
+    std::atomic<int> count{0};
+    {
+        ThreadPool pool{2};
+        for (int i{0}; i < 50; ++i) {
+            pool.submit([&count] { ++count; });
+        }
+    }
+    REQUIRE(count == 50);
+}
+
+TEST_CASE("Thread pool passes exceptions back through the future", "[threadpool]")
+{
+    ThreadPool pool{1};
+    auto result = pool.submit([]() -> int { throw std::runtime_error("oops"); });
+    REQUIRE_THROWS_AS(result.get(), std::runtime_error);
+}
+
+TEST_CASE("Parallel application gives the same result as serial", "[threadpool]")
+{
+    std::string text;
+    for (std::size_t i{0}; i < 10007; ++i) {
+        text += static_cast<char>('A' + (i * 7) % 26);
+    }
+
+    for (const auto& [type, key] :
+         {std::make_pair(CipherType::Caesar, "17"),
+          std::make_pair(CipherType::Playfair, "hello"),
+          std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        for (std::size_t nThreads : {1, 2, 3, 7}) {
+            ThreadPool pool{nThreads};
+            for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+                REQUIRE(applyCipherParallel(*cipher, text, mode, pool) ==
+                        cipher->applyCipher(text, mode));
+            }
+        }
+    }
+}
+
+TEST_CASE("Parallel in-place application gives the same result as serial", "[threadpool]")
+{
+    std::string text;
+    for (std::size_t i{0}; i < 10007; ++i) {
+        text += static_cast<char>('A' + (i * 7) % 26);
+    }
+
+    for (const auto& [type, key] :
+         {std::make_pair(CipherType::Caesar, "17"),
+          std::make_pair(CipherType::Vigenere, "hello")}) {
+        const auto cipher = cipherFactory(type, key);
+        for (std::size_t nThreads : {1, 2, 3, 7}) {
+            ThreadPool pool{nThreads};
+            for (const auto mode : {CipherMode::Encrypt, CipherMode::Decrypt}) {
+                std::string buffer{text};
+                applyCipherParallelInPlace(*cipher, buffer.data(),
+                                           buffer.size(), mode, pool);
+                REQUIRE(buffer == cipher->applyCipher(text, mode));
+            }
+        }
+    }
+
+    const auto playfair = cipherFactory(CipherType::Playfair, "hello");
+    ThreadPool pool{2};
+    REQUIRE_THROWS_AS(applyCipherParallelInPlace(*playfair, text.data(),
+                                                 text.size(),
+                                                 CipherMode::Encrypt, pool),
+                      InPlaceNotSupported);
+}
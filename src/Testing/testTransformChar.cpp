@@ -35,4 +35,38 @@ TEST_CASE("Special characters are removed", "[punctuation]")
     for (auto& c : special) {
         REQUIRE(transformChar(c) == "");
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Blocks of text are transliterated", "[block]")
+{
+    const std::string input{"Hello, World! 1 2 3... zEbRa_9\n\t"};
+    std::string output(maxTransformedCharSize * input.size(), '\0');
+    output.resize(transformText(input, output.data()));
+    REQUIRE(output == "HELLOWORLDONETWOTHREEZEBRANINE");
+}
+
+TEST_CASE("Block transliteration matches per-character transliteration", "[block]")
+{
+    std::string input;
+    for (int c{0}; c < 256; ++c) {
+        input += static_cast<char>(c);
+    }
+    std::string expected;
+    for (const char c : input) {
+        expected += transformChar(c);
+    }
+    std::string output(maxTransformedCharSize * input.size(), '\0');
+    output.resize(transformText(input, output.data()));
+    REQUIRE(output == expected);
+    REQUIRE(transformText("", output.data()) == 0);
+}
+
+TEST_CASE("Already transliterated text is recognised", "[block]")
+{
+    REQUIRE(transformedLength("") == 0);
+    REQUIRE(transformedLength("HELLOWORLD") == 10);
+    REQUIRE(transformedLength("HELLOWORLD\n") == 10);
+    REQUIRE(transformedLength("HELLO WORLD\n") == std::string_view::npos);
+    REQUIRE(transformedLength("HELLOWORLd") == std::string_view::npos);
+    REQUIRE(transformedLength("HELLO1") == std::string_view::npos);
+    REQUIRE(transformedLength("\n") == 0);
+}
@@ -12,4 +12,20 @@ TEST_CASE("Vigenere Cipher encryption", "[vigenere]") {
 TEST_CASE("Vigenere Cipher decryption", "[vigenere]") {
   VigenereCipher cc{"hello"};
   REQUIRE( cc.applyCipher("ALTDWZUFTHLEWZBNQPDGHKPDCALPVSFATWZUIPOHVVPASHXLQSDXTXSZ", CipherMode::Decrypt) == "THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES");
-}
\ No newline at end of file
+}
+TEST_CASE("Vigenere Cipher key ignores case and non-alphabet characters", "[vigenere]") {
+  VigenereCipher cc{"h-E l!LO 1"};
+  REQUIRE( cc.applyCipher("THISISQUITEALONGMESSAGESOTHEKEYWILLNEEDTOREPEATAFEWTIMES", CipherMode::Encrypt) == "ALTDWZUFTHLEWZBNQPDGHKPDCALPVSFATWZUIPOHVVPASHXLQSDXTXSZ");
+}
+
+TEST_CASE("Vigenere Cipher rejects a key with no letters", "[vigenere]") {
+  REQUIRE_THROWS_AS( VigenereCipher{"1234"}, InvalidKey );
+}
+
+TEST_CASE("Vigenere Cipher round trip", "[vigenere]") {
+  VigenereCipher cc{"zebras"};
+  const std::string plain{"ABCDEFGHIJKLMNOPQRSTUVWXYZZYXWVUTSRQPONMLKJIHGFEDCBA"};
+  const std::string encrypted{cc.applyCipher(plain, CipherMode::Encrypt)};
+  REQUIRE( encrypted.substr(0, 6) == "ZFDUEX" );
+  REQUIRE( cc.applyCipher(encrypted, CipherMode::Decrypt) == plain );
+}
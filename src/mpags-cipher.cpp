@@ -1,17 +1,94 @@
+#include "CaesarCracker.hpp"
 #include "CipherFactory.hpp"
 #include "CipherMode.hpp"
 #include "CipherType.hpp"
+#include "Instrumentation.hpp"
+#include "MappedFile.hpp"
+#include "ParallelCipher.hpp"
 #include "ProcessCommandLine.hpp"
+#include "StreamCipher.hpp"
+#include "TextChunk.hpp"
+#include "ThreadPool.hpp"
 #include "TransformChar.hpp"
 
-#include <cctype>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <future>
-#include <thread>
 
+namespace {
+    /// Read and transliterate everything from the stream, a block at a time
+    std::string readText(std::istream& inputStream)
+    {
+        std::vector<char> block(1 << 16);
+        std::string inputText;
+        while (inputStream) {
+            std::size_t nRead{0};
+            {
+                Instrumentation::StageTimer timer{Instrumentation::Stage::Read};
+                inputStream.read(block.data(),
+                                 static_cast<std::streamsize>(block.size()));
+                nRead = static_cast<std::size_t>(inputStream.gcount());
+                timer.setBytesOut(nRead);
+            }
+
+            Instrumentation::StageTimer timer{
+                Instrumentation::Stage::Transform, nRead};
+            const std::size_t textSize{inputText.size()};
+            inputText.resize(textSize + maxTransformedCharSize * nRead);
+            inputText.resize(
+                textSize + transformText(std::string_view{block.data(), nRead},
+                                         inputText.data() + textSize));
+            timer.setBytesOut(inputText.size() - textSize);
+        }
+        return inputText;
+    }
+
+    /// Write the text, followed by a newline, to the stream
+    void writeText(std::ostream& outputStream, const std::string& outputText)
+    {
+        Instrumentation::StageTimer timer{Instrumentation::Stage::Write,
+                                          outputText.size()};
+        outputStream << outputText << std::endl;
+        timer.setBytesOut(outputText.size() + 1);
+    }
+
+    /// Print or save the statistics, if requested, returning the exit code for main
+    int reportStats(const ProgramSettings& settings)
+    {
+        if (settings.statsRequested) {
+            Instrumentation::printSummary(std::cerr);
+        }
+        if (!settings.statsFile.empty()) {
+            std::ofstream statsStream{settings.statsFile};
+            if (!statsStream.good()) {
+                std::cerr << "[error] failed to create ostream on file '"
+                          << settings.statsFile << "'" << std::endl;
+                return 1;
+            }
+            Instrumentation::writeJson(statsStream);
+        }
+        return 0;
+    }
+
+    /// Apply the cipher to the input, in place if the input is held in
+    /// inputText and the cipher allows it, so that no second copy is needed
+    std::string cipherText(const Cipher& cipher, const TextChunk& input,
+                           std::string& inputText, const CipherMode cipherMode,
+                           ThreadPool& pool)
+    {
+        if (cipher.preservesLength() && !inputText.empty() &&
+            input.text.data() == inputText.data()) {
+            applyCipherParallelInPlace(cipher, inputText.data(),
+                                       inputText.size(), cipherMode, pool);
+            return std::move(inputText);
+        }
+        return applyCipherParallel(cipher, input, cipherMode, pool);
+    }
+}    // namespace
 
 int main(int argc, char* argv[])
 {
@@ -20,7 +97,7 @@ int main(int argc, char* argv[])
 
     // Options that might be set by the command-line arguments
     ProgramSettings settings{
-        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar};
+        false, false, "", "", "", CipherMode::Encrypt, CipherType::Caesar, 0, false, false, ""};
 
     // Process command line arguments
     try
@@ -39,13 +116,18 @@ int main(int argc, char* argv[])
       std::cerr << "[error] unknown argument: " << error.what() << std::endl;
       return 1;
     }
+    catch (const InvalidArgument& error)
+    {
+      std::cerr << "[error] invalid argument: " << error.what() << std::endl;
+      return 1;
+    }
 
 
     // Handle help, if requested
     if (settings.helpRequested) {
         // Line splitting for readability
         std::cout
-            << "Usage: mpags-cipher [-h/--help] [--version] [-i <file>] [-o <file>] [-c <cipher>] [-k <key>] [--encrypt/--decrypt]\n\n"
+            << "Usage: mpags-cipher [-h/--help] [--version] [-i <file>] [-o <file>] [-c <cipher>] [-k <key>] [--encrypt/--decrypt] [--threads <n>] [--stream] [--stats] [--stats-file <file>] [--crack] [--crack-sample <n>]\n\n"
             << "Encrypts/Decrypts input alphanumeric text using classical ciphers\n\n"
             << "Available options:\n\n"
             << "  -h|--help        Print this help message and exit\n\n"
@@ -61,6 +143,17 @@ int main(int argc, char* argv[])
             << "                   A null key, i.e. no encryption, is used if not supplied\n\n"
             << "  --encrypt        Will use the cipher to encrypt the input text (default behaviour)\n\n"
             << "  --decrypt        Will use the cipher to decrypt the input text\n\n"
+            << "  --threads N      Share the work of applying the cipher between N threads\n"
+            << "                   One thread per hardware thread is used if not supplied\n\n"
+            << "  --stream         Read, process and write the text a block at a time,\n"
+            << "                   so that memory use does not grow with the size of the input\n\n"
+            << "  --stats          Print the time spent in, and the bytes passed through,\n"
+            << "                   each stage of the processing to stderr at exit\n\n"
+            << "  --stats-file FILE\n"
+            << "                   Write the same statistics to FILE as JSON\n\n"
+            << "  --crack          Find the key of Caesar-enciphered input by comparing its\n"
+            << "                   letter frequencies with English, then decrypt it with that key\n\n"
+            << "  --crack-sample N Only use the first N KB of the input to find the key\n\n"
             << std::endl;
         // Help requires no further action, so return from main
         // with 0 used to indicate success
@@ -75,31 +168,16 @@ int main(int argc, char* argv[])
         return 0;
     }
 
-    // Initialise variables
-    char inputChar{'x'};
-    std::string inputText;
-
-    // Read in user input from stdin/file
-    if (!settings.inputFile.empty()) {
-        // Open the file and check that we can read from it
-        std::ifstream inputStream{settings.inputFile};
-        if (!inputStream.good()) {
-            std::cerr << "[error] failed to create istream on file '"
-                      << settings.inputFile << "'" << std::endl;
-            return 1;
-        }
-
-        // Loop over each character from the file
-        while (inputStream >> inputChar) {
-            inputText += transformChar(inputChar);
-        }
-
-    } else {
-        // Loop over each character from user input
-        // (until Return then CTRL-D (EOF) pressed)
-        while (std::cin >> inputChar) {
-            inputText += transformChar(inputChar);
-        }
+    // Cracking finds a Caesar key from the whole input, so needs it all at once
+    if (settings.crackRequested && settings.cipherType != CipherType::Caesar) {
+        std::cerr << "[error] --crack can only be used with the caesar cipher"
+                  << std::endl;
+        return 1;
+    }
+    if (settings.crackRequested && settings.streamMode) {
+        std::cerr << "[error] --crack cannot be used with --stream"
+                  << std::endl;
+        return 1;
     }
 
     // Request construction of the appropriate cipher
@@ -121,47 +199,138 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    // Run the cipher on the input text, specifying whether to encrypt/decrypt
+    // Start recording the time spent in each stage, if requested
+    if (settings.statsRequested || !settings.statsFile.empty()) {
+        if (!Instrumentation::compiledIn()) {
+            std::cerr << "[warning] statistics were not compiled into this build"
+                      << std::endl;
+        }
+        Instrumentation::enable(true);
+    }
 
-    // multithreading on substrings of inputText
-    int nThreads{4};
-    std::vector<std::future <std::string>> futures{};
-    std::vector <std::string> substrs{};
+    // Share the work of applying the cipher between a pool of worker threads
+    ThreadPool pool{settings.nThreads};
 
-    for (int i{0}; i < nThreads; ++i)
-    {
-      substrs = cipher->splitString(inputText, nThreads); //get substrings
-      auto applyCipher_lamba = [&] () { return cipher->applyCipher(substrs[i], settings.cipherMode); };
-      auto future = std::async(std::launch::async, applyCipher_lamba);
-      futures.push_back(std::move(future) ); // start thread
+    // In stream mode, read, cipher and write the text a block at a time
+    if (settings.streamMode) {
+        std::ifstream inputFileStream;
+        if (!settings.inputFile.empty()) {
+            // Open the file and check that we can read from it
+            inputFileStream.open(settings.inputFile, std::ios::binary);
+            if (!inputFileStream.good()) {
+                std::cerr << "[error] failed to create istream on file '"
+                          << settings.inputFile << "'" << std::endl;
+                return 1;
+            }
+        }
+        std::ofstream outputFileStream;
+        if (!settings.outputFile.empty()) {
+            // Open the file and check that we can write to it
+            outputFileStream.open(settings.outputFile, std::ios::binary);
+            if (!outputFileStream.good()) {
+                std::cerr << "[error] failed to create ostream on file '"
+                          << settings.outputFile << "'" << std::endl;
+                return 1;
+            }
+        }
+
+        std::istream& inputStream{settings.inputFile.empty() ? std::cin
+                                                            : inputFileStream};
+        std::ostream& outputStream{
+            settings.outputFile.empty() ? std::cout : outputFileStream};
+        applyCipherStream(*cipher, inputStream, outputStream,
+                          settings.cipherMode, pool);
+        outputStream.flush();
+        return reportStats(settings);
     }
 
-    std::future_status status{std::future_status::ready};
+    // Read in user input from stdin/file
+    // Files are mapped into memory where possible, and if the file is
+    // already transliterated (e.g. it was written by mpags-cipher) the
+    // cipher then reads it straight from the mapped pages without copying
+    std::optional<MappedFile> inputMap;
+    std::string inputText;
+    std::string_view inputView;
+    if (!settings.inputFile.empty() && MappedFile::supported) {
+        try {
+            Instrumentation::StageTimer timer{Instrumentation::Stage::Read};
+            inputMap = MappedFile::openForReading(settings.inputFile);
+            timer.setBytesOut(inputMap->size());
+        } catch (const FileError& error) {
+            std::cerr << "[error] " << error.what() << std::endl;
+            return 1;
+        }
+        const std::string_view mappedText{inputMap->data(), inputMap->size()};
+        Instrumentation::StageTimer timer{Instrumentation::Stage::Transform,
+                                          mappedText.size()};
+        const std::size_t nTransformed{transformedLength(mappedText)};
+        if (nTransformed != std::string_view::npos &&
+            !inputMap->refersTo(settings.outputFile)) {
+            inputView = mappedText.substr(0, nTransformed);
+        } else {
+            inputText.resize(maxTransformedCharSize * mappedText.size());
+            inputText.resize(transformText(mappedText, inputText.data()));
+            inputView = inputText;
+        }
+        timer.setBytesOut(inputView.size());
 
-    do
-    {
-      for (int i{0}; i < nThreads; ++i)
-      {
-        status = futures[i].wait_for(std::chrono::seconds(1)); // get status
-        if(status == std::future_status::timeout)
-        {
-          std::cout << "processing\n";
+    } else if (!settings.inputFile.empty()) {
+        // Open the file and check that we can read from it
+        std::ifstream inputStream{settings.inputFile, std::ios::binary};
+        if (!inputStream.good()) {
+            std::cerr << "[error] failed to create istream on file '"
+                      << settings.inputFile << "'" << std::endl;
+            return 1;
         }
-      }
+        inputText = readText(inputStream);
+        inputView = inputText;
 
+    } else {
+        // Read user input (until Return then CTRL-D (EOF) pressed)
+        inputText = readText(std::cin);
+        inputView = inputText;
     }
-    while (status != std::future_status::ready);
 
-    std::string outputText{};
-    // combine substrings to get final result
-    for (int i{0}; i < nThreads; ++i)
-    {
-      outputText += substrs[i];
+    // If requested, find the most likely key, and decrypt with it
+    if (settings.crackRequested) {
+        const CaesarCracker::CrackResult result{CaesarCracker::crack(
+            inputView, pool, 1024 * settings.crackSampleKB)};
+        std::cerr << "[crack] most likely key: " << result.key << " (from "
+                  << result.nLetters << " letters, chi-squared "
+                  << result.chiSquared[result.key] << ")" << std::endl;
+        cipher = cipherFactory(CipherType::Caesar, std::to_string(result.key));
+        settings.cipherMode = CipherMode::Decrypt;
     }
 
+    // Run the cipher on the input text, specifying whether to encrypt/decrypt,
+    // and output the encrypted/decrypted text to stdout/file
+    const TextChunk input{inputView, 0};
+    if (!settings.outputFile.empty() && MappedFile::supported) {
+        // Create the output file big enough for the longest possible result
+        // (plus a newline), write straight into it, then cut it down to size
+        try {
+            std::optional<MappedFile> outputMap;
+            {
+                Instrumentation::StageTimer timer{Instrumentation::Stage::Write};
+                outputMap = MappedFile::createForWriting(
+                    settings.outputFile,
+                    cipher->maxOutputSize(inputView.size()) + 1);
+            }
+            const std::size_t nWritten{applyCipherParallel(
+                *cipher, input, outputMap->data(), settings.cipherMode, pool)};
 
-    // Output the encrypted/decrypted text to stdout/file
-    if (!settings.outputFile.empty()) {
+            Instrumentation::StageTimer timer{Instrumentation::Stage::Write,
+                                              nWritten};
+            outputMap->data()[nWritten] = '\n';
+            outputMap->truncate(nWritten + 1);
+            outputMap.reset();
+            timer.setBytesOut(nWritten + 1);
+        } catch (const FileError& error) {
+            std::cerr << "[error] " << error.what() << std::endl;
+            return 1;
+        }
+
+    } else if (!settings.outputFile.empty()) {
         // Open the file and check that we can write to it
         std::ofstream outputStream{settings.outputFile};
         if (!outputStream.good()) {
@@ -171,14 +340,16 @@ int main(int argc, char* argv[])
         }
 
         // Print the encrypted/decrypted text to the file
-        outputStream << outputText << std::endl;
+        writeText(outputStream, cipherText(*cipher, input, inputText,
+                                           settings.cipherMode, pool));
 
     } else {
         // Print the encrypted/decrypted text to the screen
-        std::cout << outputText << std::endl;
+        writeText(std::cout, cipherText(*cipher, input, inputText,
+                                        settings.cipherMode, pool));
     }
 
     // No requirement to return from main, but we do so for clarity
     // and for consistency with other functions
-    return 0;
+    return reportStats(settings);
 }